@@ -0,0 +1,229 @@
+#include "FastLED.h"
+
+/**************************************
+   S E T U P
+
+   set following values to your needs
+ **************************************/
+
+#define INITIAL_LED_TEST_ENABLED true
+#define INITIAL_LED_TEST_BRIGHTNESS 32  // 0..255
+#define INITIAL_LED_TEST_TIME_MS 500  // 10..
+
+// Number of leds in your strip
+#define MAX_LEDS 500
+
+// type of your led controller, possible values, see below
+#define LED_TYPE WS2812B
+
+// 3 wire (pwm): NEOPIXEL BTM1829 TM1812 TM1809 TM1804 TM1803 UCS1903 UCS1903B UCS1904 UCS2903 WS2812 WS2852
+//               S2812B SK6812 SK6822 APA106 PL9823 WS2811 WS2813 APA104 WS2811_40 GW6205 GW6205_40 LPD1886 LPD1886_8BIT
+// 4 wire (spi): LPD8806 WS2801 WS2803 SM16716 P9813 APA102 SK9822 DOTSTAR
+
+// For 3 wire led stripes line Neopixel/Ws2812, which have a data line, ground, and power, you just need to define DATA_PIN.
+// For led chipsets that are SPI based (four wires - data, clock, ground, and power), both defines DATA_PIN and CLOCK_PIN are needed
+
+// DATA_PIN, or DATA_PIN, CLOCK_PIN
+#define LED_PINS 6        // 3 wire leds
+//#define LED_PINS 6, 13  // 4 wire leds
+
+#define COLOR_ORDER GRB  // colororder of the stripe, set RGB in hyperion
+
+#define OFF_TIMEOUT 15000    // ms to switch off after no data was received, set 0 to deactivate
+
+#define BRIGHTNESS 255                      // maximum brightness 0-255
+#define DITHER_MODE BINARY_DITHER           // BINARY_DITHER or DISABLE_DITHER
+#define COLOR_TEMPERATURE CRGB(255,255,255) // RGB value describing the color temperature
+#define COLOR_CORRECTION  TypicalLEDStrip   // predefined fastled color correction
+//#define COLOR_CORRECTION  CRGB(255,255,255) // or RGB value describing the color correction
+
+// Baudrate, higher rate allows faster refresh rate and more LEDs
+//#define serialRate 115200      // use 115200 for ftdi based boards
+#define serialRate 500000
+
+
+/**************************************
+   A D A L I G H T   V 2   C O D E
+
+   no user changes needed
+
+   Frame:   'A' 'd' 'b' <length hi> <length lo> <length hi ^ length lo ^ 0x55> <segments> <checksum>
+            length is the number of bytes of all segments, checksum is the XOR of all segment bytes and 0x55
+   Segment: <first led hi> <first led lo> <led count> <mode> <colors>
+            mode 0 (raw): led count RGB colors follow
+            mode 1 (run): one RGB color follows, which is set for all led count leds
+   LEDs which are not part of any segment keep their color.
+
+   After a frame was shown 'K' is sent, on a checksum mismatch 'N' is sent and the frame is not shown.
+   The host does not send the next frame before the reply, so no data is lost while the leds are updated.
+   Classic 'Ada' frames are still supported, they are not replied to.
+ **************************************/
+
+#define REPLY_SHOWN    'K'
+#define REPLY_REJECTED 'N'
+
+#define SEGMENT_RAW 0
+#define SEGMENT_RUN 1
+
+unsigned long endTime;
+
+// Define the array of leds
+CRGB leds[MAX_LEDS];
+
+// switch off all leds
+void switchOff() {
+  memset(leds, 0, MAX_LEDS * sizeof(struct CRGB));
+  FastLED.show();
+}
+
+// wait for the next byte, -1 if the off timeout occured while waiting
+int readByte() {
+  while (!Serial.available()) {
+    if (OFF_TIMEOUT > 0 && endTime < millis()) {
+      switchOff();
+      endTime = millis() + OFF_TIMEOUT;
+      return -1;
+    }
+  }
+  return Serial.read();
+}
+
+// read a color, false if the off timeout occured while waiting
+bool readColor(CRGB& color, uint8_t& checksum) {
+  int r = readByte();
+  int g = readByte();
+  int b = readByte();
+  if (r < 0 || g < 0 || b < 0) {
+    return false;
+  }
+  color.r = r;
+  color.g = g;
+  color.b = b;
+  checksum ^= r ^ g ^ b;
+  return true;
+}
+
+// classic frame, colors of (hi << 8) + lo + 1 leds
+bool readClassicFrame(int hi, int lo) {
+  int count = (hi << 8) + lo + 1;
+  uint8_t checksum = 0;
+  CRGB color;
+
+  for (int idx = 0; idx < count; idx++) {
+    if (!readColor(color, checksum)) {
+      return false;
+    }
+    if (idx < MAX_LEDS) {
+      leds[idx] = color;
+    }
+  }
+  return true;
+}
+
+// v2 frame, segments of length bytes followed by their checksum
+bool readFrameV2(int hi, int lo) {
+  long remaining = ((long)hi << 8) + lo;
+  uint8_t checksum = 0x55;
+  CRGB color;
+
+  while (remaining >= 4) {
+    int startHi = readByte();
+    int startLo = readByte();
+    int count = readByte();
+    int mode = readByte();
+    if (startHi < 0 || startLo < 0 || count < 0 || mode < 0) {
+      return false;
+    }
+    checksum ^= startHi ^ startLo ^ count ^ mode;
+    remaining -= 4;
+
+    int start = (startHi << 8) + startLo;
+    if (mode == SEGMENT_RUN) {
+      if (!readColor(color, checksum)) {
+        return false;
+      }
+      remaining -= 3;
+      for (int idx = start; idx < start + count && idx < MAX_LEDS; idx++) {
+        leds[idx] = color;
+      }
+    } else {
+      for (int idx = start; idx < start + count; idx++) {
+        if (!readColor(color, checksum)) {
+          return false;
+        }
+        if (idx < MAX_LEDS) {
+          leds[idx] = color;
+        }
+      }
+      remaining -= 3L * count;
+    }
+  }
+
+  int expected = readByte();
+  if (expected < 0) {
+    return false;
+  }
+
+  // a corrupted frame is not shown, the host answers with a complete frame
+  if (remaining != 0 || expected != checksum) {
+    Serial.write(REPLY_REJECTED);
+    return false;
+  }
+  return true;
+}
+
+// main function that setups and runs the code
+void setup() {
+  Serial.begin(serialRate);
+
+  FastLED.addLeds<LED_TYPE, LED_PINS, COLOR_ORDER>(leds, MAX_LEDS);
+
+  // color adjustments
+  FastLED.setBrightness ( BRIGHTNESS );
+  FastLED.setTemperature( COLOR_TEMPERATURE );
+  FastLED.setCorrection ( COLOR_CORRECTION );
+  FastLED.setDither     ( DITHER_MODE );
+
+  // initial RGB flash
+  #if INITIAL_LED_TEST_ENABLED == true
+  for (int v=0;v<INITIAL_LED_TEST_BRIGHTNESS;v++)
+  {
+    LEDS.showColor(CRGB(v,v,v));
+    delay(INITIAL_LED_TEST_TIME_MS/2/INITIAL_LED_TEST_BRIGHTNESS);
+  }
+  #endif
+  switchOff();
+
+  Serial.print("Ada\n"); // Send "Magic Word" string to host
+  endTime = millis() + OFF_TIMEOUT;
+}
+
+void loop() {
+  // wait for the Magic Word, 'Ada' (classic) or 'Adb' (v2)
+  if (readByte() != 'A' || readByte() != 'd') {
+    return;
+  }
+  int version = readByte();
+  if (version != 'a' && version != 'b') {
+    return;
+  }
+
+  // Hi, Lo, Checksum
+  int hi = readByte();
+  int lo = readByte();
+  int chk = readByte();
+  if (hi < 0 || lo < 0 || chk != (hi ^ lo ^ 0x55)) {
+    return;
+  }
+
+  bool transmissionSuccess = (version == 'a') ? readClassicFrame(hi, lo) : readFrameV2(hi, lo);
+
+  // shows new values
+  if (transmissionSuccess) {
+    endTime = millis() + OFF_TIMEOUT;
+    FastLED.show();
+    if (version == 'b') {
+      Serial.write(REPLY_SHOWN);
+    }
+  }
+}
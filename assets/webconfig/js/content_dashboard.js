@@ -116,8 +116,35 @@ $(document).ready( function() {
 	$('#dash_platform').html(html);
 
 
+	function formatLatency(us)
+	{
+		return (us >= 1000) ? (us/1000).toFixed(1)+' ms' : us+' µs';
+	}
+
+	async function updateMetrics()
+	{
+		// stop polling as soon as the dashboard is left
+		if($('#tab_metrics').length == 0)
+			return;
+
+		const res = await requestMetrics();
+		if(res && res.success)
+		{
+			var stages = res.info.stages;
+			var metrics_html = "";
+			for(var stage in stages)
+			{
+				metrics_html += '<tr><td>'+$.i18n('dashboard_metricsbox_stage_'+stage)+'</td><td>'+formatLatency(stages[stage].p50)+'</td><td>'+formatLatency(stages[stage].p99)+'</td><td>'+formatLatency(stages[stage].max)+'</td></tr>';
+			}
+			$("#tab_metrics").html(metrics_html);
+			$("#dash_metrics_frames").html($.i18n('dashboard_metricsbox_label_frames', res.info.render.frames, res.info.render.skipped));
+		}
+		setTimeout(updateMetrics, 2000);
+	}
+
 	//interval update
 	updateComponents();
+	updateMetrics();
 	$(window.hyperion).on("components-updated",updateComponents);
 
 	if(window.showOptHelp)
@@ -461,6 +461,11 @@ async function requestLedDeviceDiscovery(type)
 	return sendAsyncToHyperion("leddevice", "discover", data, Math.floor(Math.random() * 1000) );
 }
 
+async function requestMetrics()
+{
+	return sendAsyncToHyperion("metrics", "get", {}, Math.floor(Math.random() * 1000));
+}
+
 async function requestLedDeviceProperties(type, params)
 {
 	let data = { ledDeviceType: type, params: params };
@@ -7,10 +7,14 @@
 #include <utils/Components.h>
 #include <hyperion/Hyperion.h>
 #include <hyperion/HyperionIManager.h>
+#include <hyperion/StreamPublisher.h>
 
 // qt includes
 #include <QJsonObject>
 #include <QString>
+#include <QJsonArray>
+#include <QMap>
+#include <QVector>
 
 class QTimer;
 class JsonCB;
@@ -39,11 +43,24 @@ public:
 	///
 	void handleMessage(const QString &message, const QString &httpAuthHeader = "");
 
+	///
+	/// Handle an incoming JSON message, parsed without conversion to QString
+	///
+	/// @param message the incoming message, utf8 encoded
+	///
+	void handleMessage(const QByteArray &message, const QString &httpAuthHeader = "");
+
 	///
 	/// @brief Initialization steps
 	///
 	void initialize();
 
+	///
+	/// @brief Allow the ledcolors binarystream, just for transports which deliver callbackBinaryMessage (WebSocket)
+	/// @param supported  True if binary messages are supported
+	///
+	void setBinaryStreamingSupported(bool supported) { _binaryStreamingSupported = supported; }
+
 public slots:
 	///
 	/// @brief Is called whenever the current Hyperion instance pushes new led raw values (if enabled)
@@ -52,10 +69,12 @@ public slots:
 	void streamLedcolorsUpdate(const std::vector<ColorRgb> &ledColors);
 
 	///
-	/// @brief Push images whenever hyperion emits (if enabled)
-	/// @param image  The current image
+	/// @brief Push the encoded images of the image stream (if enabled)
+	/// @param frame   The encoded image, jpg data url or binary frame payload
+	/// @param width   The image width
+	/// @param height  The image height
 	///
-	void setImage(const Image<ColorRgb> &image);
+	void setImage(const QByteArray &frame, int width, int height);
 
 	///
 	/// @brief Process and push new log messages from logger (if enabled)
@@ -93,6 +112,11 @@ signals:
 	///
 	void callbackMessage(QJsonObject);
 
+	///
+	/// Signal emits with a frame of the binary led/image stream
+	///
+	void callbackBinaryMessage(QByteArray);
+
 	///
 	/// Signal emits whenever a JSON-message should be forwarded
 	///
@@ -125,6 +149,104 @@ private:
 	/// the current streaming led values
 	std::vector<ColorRgb> _currentLedValues;
 
+	/// true if the transport can deliver binary messages
+	bool _binaryStreamingSupported;
+
+	/// state of the binary led/image stream
+	struct BinaryStream
+	{
+		bool leds = false;
+		bool delta = false;
+		bool image = false;
+		bool jpg = false;
+		int imageWidth = 160;
+		int interval = 40;
+		quint16 sequence = 0;
+		int framesSinceKeyFrame = 0;
+		std::vector<ColorRgb> lastLeds;
+	} _binaryStream;
+
+	/// subscription of the image stream, shared encoding with other clients
+	QSharedPointer<StreamSubscription> _imageStream;
+
+	/// a color or image input which is not applied yet
+	struct PendingInput
+	{
+		int priority = 0;
+		QJsonObject message;
+		bool isImage = false;
+		std::vector<uint8_t> colors;
+		int duration = -1;
+		QString origin;
+		ImageCmdData image;
+	};
+
+	/// color and image inputs in arrival order while a batch is handled, a newer input replaces an older one of the same priority
+	QVector<PendingInput> _pendingInputs;
+
+	/// collects the replies while a batch is handled, nullptr otherwise
+	QJsonArray *_batchReplies;
+
+	///
+	/// @brief Handle a single command of a message or batch
+	/// @param message         The parsed command
+	/// @param httpAuthHeader  The authorization header of http requests
+	///
+	void handleCommand(const QJsonObject &message, const QString &httpAuthHeader);
+
+	///
+	/// @brief Handle an array of commands and reply with a single message
+	/// @param batch           The parsed commands
+	/// @param httpAuthHeader  The authorization header of http requests
+	///
+	void handleBatch(const QJsonArray &batch, const QString &httpAuthHeader);
+
+	///
+	/// @brief Queue a color or image input, replaces a pending input of the same priority.
+	/// Outside of a batch the input is applied right away, before the reply is sent.
+	/// @param input     The input
+	///
+	void queueInput(const PendingInput &input);
+
+	///
+	/// @brief Drop the pending input of a priority
+	/// @param priority  The priority of the input
+	///
+	void removePendingInput(int priority);
+
+	///
+	/// @brief Apply all pending color and image inputs in the order they arrived
+	///
+	void flushPendingInputs();
+
+	///
+	/// @brief Start to push the led colors in the given interval
+	/// @param interval  The interval in ms
+	///
+	void startLedStream(int interval);
+
+	///
+	/// @brief Push led colors as binary frame, raw or delta encoded against the last frame
+	/// @param ledColors  The current led colors
+	///
+	void sendBinaryLedColors(const std::vector<ColorRgb> &ledColors);
+
+	///
+	/// @brief Subscribe to the image stream of the current instance, replaces a previous subscription
+	/// @param format    The encoding
+	/// @param width     The image width, 0 for full size
+	/// @param interval  The minimum time between two images in ms
+	///
+	void startImageStream(StreamSubscription::Format format, int width, int interval);
+
+	///
+	/// @brief Create the 8 byte header of a binary stream frame
+	/// @param type    The frame type
+	/// @param width   The led count or the image width
+	/// @param height  The image height, 0 for leds
+	///
+	QByteArray binaryFrameHeader(quint8 type, quint16 width, quint16 height);
+
 	///
 	/// @brief Handle the switches of Hyperion instances
 	/// @param instance the instance to switch
@@ -277,6 +399,12 @@ private:
 	///
 	void handleLedDeviceCommand(const QJsonObject &message, const QString &command, int tan);
 
+	/// Handle an incoming JSON Metrics message
+	///
+	/// @param message the incoming message
+	///
+	void handleMetricsCommand(const QJsonObject &message, const QString &command, int tan);
+
 	///
 	/// Handle an incoming JSON message of unknown type
 	///
@@ -299,6 +427,13 @@ private:
 	///
 	void sendErrorReply(const QString &error, const QString &command = "", int tan = 0);
 
+	///
+	/// Send a reply, or add it to the combined reply of the current batch
+	///
+	/// @param reply The reply
+	///
+	void sendReply(const QJsonObject &reply);
+
 	///
 	/// @brief Kill all signal/slot connections to stop possible data emitter
 	///
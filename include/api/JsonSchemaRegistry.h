@@ -0,0 +1,45 @@
+#pragma once
+
+// qt incl
+#include <QHash>
+#include <QJsonObject>
+#include <QString>
+
+class Logger;
+
+///
+/// @brief Registry of all JSON-RPC schemas (":/schema" and ":/schema-<command>")
+///
+/// The schemas are read and parsed once when the registry is created, every message is validated
+/// against the parsed schema instead of reading and parsing the schema file again.
+/// The registry is read-only after construction and may be used from all API threads.
+///
+class JsonSchemaRegistry
+{
+public:
+	///
+	/// @brief Get the registry, the schemas are loaded on first access
+	///
+	static const JsonSchemaRegistry& getInstance();
+
+	///
+	/// @brief Validate a message against a registered schema
+	/// @param ident   The origin of the message, just used for log messages
+	/// @param message The message to validate
+	/// @param schema  The schema name, e.g. "schema" or "schema-color"
+	/// @param log     The logger of the caller to print errors
+	/// @return        True on success, false on validation errors or if the schema is unknown
+	///
+	bool validate(const QString& ident, const QJsonObject& message, const QString& schema, Logger* log) const;
+
+	///
+	/// @brief Get the number of registered schemas
+	///
+	int count() const { return _schemas.size(); }
+
+private:
+	JsonSchemaRegistry();
+
+	/// schema name -> parsed schema
+	QHash<QString, QJsonObject> _schemas;
+};
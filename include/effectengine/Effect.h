@@ -17,6 +17,7 @@
 // Hyperion includes
 #include <utils/Components.h>
 #include <utils/Image.h>
+#include <utils/ImagePool.h>
 
 #include <atomic>
 
@@ -96,4 +97,7 @@ private:
 	QImage          _image;
 	QPainter       *_painter;
 	QVector<QImage> _imageStack;
+
+	/// Output images of imageShow, recycled to avoid an allocation per frame
+	ImagePool<ColorRgb> _outputImages;
 };
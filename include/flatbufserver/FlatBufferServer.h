@@ -9,11 +9,13 @@
 
 class QTcpServer;
 class FlatBufferClient;
+class FlatBufferUdpReceiver;
 class NetOrigin;
 
 
 ///
 /// @brief A TcpServer to receive images of different formats with Google Flatbuffer
+/// Optionally the same requests are accepted via UDP at the same port number, see FlatBufferUdpReceiver
 /// Images will be forwarded to all Hyperion instances
 ///
 class FlatBufferServer : public QObject
@@ -39,6 +41,11 @@ private slots:
 	///
 	void newConnection();
 
+	///
+	/// @brief Forward the requests of a new TCP or UDP client
+	///
+	void addClient(FlatBufferClient* client);
+
 	///
 	/// @brief is called whenever a client disconnected
 	///
@@ -58,10 +65,12 @@ private:
 
 private:
 	QTcpServer* _server;
+	FlatBufferUdpReceiver* _udpReceiver;
 	NetOrigin* _netOrigin;
 	Logger* _log;
 	int _timeout;
 	quint16 _port;
+	bool _udpEnabled;
 	const QJsonDocument _config;
 
 	QVector<FlatBufferClient*> _openConnections;
@@ -13,6 +13,7 @@
 #include <utils/ColorRgb.h>
 #include <utils/VideoMode.h>
 #include <utils/settings.h>
+#include <utils/PipelineMetrics.h>
 
 class Grabber;
 class GlobalSignals;
@@ -103,7 +104,9 @@ public:
 			_image.resize(w, h);
 		}
 
+		const int64_t grabStart = PipelineMetrics::now_us();
 		int ret = grabber.grabFrame(_image);
+		PipelineMetrics::capture().record(PipelineMetrics::GRAB, PipelineMetrics::now_us() - grabStart);
 		if (ret >= 0)
 		{
 			emit systemImage(_grabberName, _image);
@@ -11,12 +11,16 @@
 #include <QJsonValue>
 #include <QJsonArray>
 #include <QMap>
+#include <QElapsedTimer>
+#include <QSharedPointer>
 
 // hyperion-utils includes
 #include <utils/Image.h>
 #include <utils/ColorRgb.h>
+#include <utils/ColorRgb16.h>
 #include <utils/Components.h>
 #include <utils/VideoMode.h>
+#include <utils/PipelineMetrics.h>
 
 // Hyperion includes
 #include <hyperion/LedString.h>
@@ -48,6 +52,8 @@ class CaptureCont;
 class BoblightServer;
 class LedDeviceWrapper;
 class Logger;
+class QTimer;
+class StreamPublisher;
 
 ///
 /// The main class of Hyperion. This gives other 'users' access to the attached LedDevice through
@@ -60,6 +66,25 @@ public:
 	///  Type definition of the info structure used by the priority muxer
 	using InputInfo = PriorityMuxer::InputInfo;
 
+	///
+	/// @brief Durations of the render pipeline stages of the last frame and the frame counters
+	///
+	struct RenderTimings
+	{
+		/// image to leds mapping in us
+		qint64  map_us    = 0;
+		/// color adjustment and color order in us
+		qint64  adjust_us = 0;
+		/// hand-over to smoothing in us
+		qint64  smooth_us = 0;
+		/// last LedDevice write in us
+		qint64  write_us  = 0;
+		/// number of frames rendered
+		quint64 frames    = 0;
+		/// number of render loop ticks skipped as they were too late
+		quint64 skipped   = 0;
+	};
+
 	///
 	/// Destructor; cleans up resources
 	///
@@ -98,11 +123,42 @@ public:
 	///
 	QString getActiveDeviceType() const;
 
+	///
+	/// @brief Get the per stage timings of the render pipeline
+	/// @return The timings of the last frame
+	///
+	RenderTimings getRenderTimings() const;
+
+	///
+	/// @brief Get the latency histograms of the pipeline stages of this instance
+	/// @return The metrics, thread-safe to read
+	///
+	PipelineMetrics& getMetrics() { return *_metrics; }
+
+	///
+	/// @brief Get a handle of the metrics, which keeps them valid after this instance has been deleted
+	/// @return The metrics, thread-safe to read
+	///
+	QSharedPointer<PipelineMetrics> getSharedMetrics() const { return _metrics; }
+
+	///
+	/// @brief Get the publisher of the live image stream, which encodes every frame once for all stream clients
+	/// @return The publisher, nullptr until the instance is started. Subscribing is thread-safe
+	///
+	StreamPublisher* getStreamPublisher() const { return _streamPublisher; }
+
+	///
+	/// @brief Check, if the fixed-rate render loop is active
+	/// @return True, if the muxer is sampled with a fixed rate
+	///
+	bool isRenderLoopActive() const;
+
 public slots:
 
 	///
 	/// Updates the priority muxer with the current time and (re)writes the led color with applied
-	/// transforms.
+	/// transforms. With an active render loop the update is deferred to the next render tick, otherwise
+	/// until the pending events of the instance are processed, so a burst of inputs is rendered once.
 	///
 	void update();
 
@@ -251,6 +307,12 @@ public slots:
 	///
 	PriorityMuxer* getMuxerInstance() { return &_muxer; }
 
+	///
+	/// @brief Get the message forwarder, which exists only on the main instance
+	/// @return      MessageForwarder instance pointer or nullptr
+	///
+	MessageForwarder* getMessageForwarder() const { return _messageForwarder; }
+
 	///
 	/// @brief enable/disable automatic/priorized source selection
 	/// @param state The new state
@@ -439,6 +501,11 @@ signals:
 	///
 	void ledDeviceData(const std::vector<ColorRgb>& ledValues);
 
+	///
+	/// @brief Emits instead of ledDeviceData() with the high precision pipeline enabled, the device dithers the values to 8 bit
+	///
+	void ledDeviceData16(const std::vector<ColorRgb16>& ledValues);
+
 	///
 	/// @brief Emits whenever new untransformed ledColos data is available, reflects the current visible device
 	///
@@ -473,6 +540,11 @@ private slots:
 	///
 	void handleNewVideoMode(VideoMode mode) { _currVideoMode = mode; }
 
+	///
+	/// @brief Render loop tick, samples the muxer once and renders a frame when new input is pending
+	///
+	void handleRenderTick();
+
 private:
 	friend class HyperionDaemon;
 	friend class HyperionIManager;
@@ -483,6 +555,22 @@ private:
 	///
 	Hyperion(quint8 instance);
 
+	///
+	/// @brief Sample the muxer and write the resulting led colors through adjustment, smoothing to the device
+	///
+	void render();
+
+	///
+	/// @brief Apply the render loop configuration from the smoothing settings
+	/// @param config The smoothing configuration
+	///
+	void updateRenderLoop(const QJsonObject& config);
+
+	///
+	/// @brief Arm the render timer for the next tick based on the monotonic render clock
+	///
+	void scheduleRenderTick();
+
 	/// instance index
 	const quint8 _instIndex;
 
@@ -492,6 +580,9 @@ private:
 	/// Register that holds component states
 	ComponentRegister _componentRegister;
 
+	/// Latency histograms of the pipeline stages, shared with readers in other threads
+	const QSharedPointer<PipelineMetrics> _metrics;
+
 	/// The specifiation of the led frame construction and picture integration
 	LedString _ledString;
 
@@ -534,8 +625,36 @@ private:
 	/// buffer for leds (with adjustment)
 	std::vector<ColorRgb> _ledBuffer;
 
+	/// buffer for leds with adjustment in 16 bit precision, used if dithering is enabled for the device
+	std::vector<ColorRgb16> _ledBuffer16;
+	bool _isHighPrecision;
+
 	VideoMode _currVideoMode = VideoMode::VIDEO_2D;
 
 	/// Boblight instance
 	BoblightServer* _boblightServer;
+
+	/// Publisher of the live image stream
+	StreamPublisher* _streamPublisher;
+
+	/// Timer of the fixed-rate render loop, a zero timer coalescing the updates when rendering on demand
+	QTimer* _renderTimer;
+
+	/// Monotonic clock the render ticks are scheduled against
+	QElapsedTimer _renderClock;
+
+	/// Interval between two render ticks in ns
+	qint64 _renderInterval_ns;
+
+	/// Deadline of the next render tick in ns on the render clock
+	qint64 _nextRenderTime_ns;
+
+	/// New input arrived since the last render tick
+	bool _renderPending;
+
+	/// Stage timings of the last rendered frame
+	RenderTimings _renderTimings;
+
+	/// Arrival of the input which is not yet handed to the device, used for the latency metric
+	int64_t _inputTime_us;
 };
@@ -8,6 +8,10 @@
 
 // qt
 #include <QMap>
+#include <QMutex>
+#include <QSharedPointer>
+
+class PipelineMetrics;
 
 class Hyperion;
 class InstanceTable;
@@ -32,6 +36,19 @@ public:
 	static HyperionIManager* getInstance() { return HIMinstance; }
 	static HyperionIManager* HIMinstance;
 
+	/// The metrics of a running instance
+	struct InstanceMetrics
+	{
+		QString name;
+		QSharedPointer<PipelineMetrics> metrics;
+	};
+
+	///
+	/// @brief Get the metrics of all running instances, thread-safe
+	/// @return The metrics by instance index, still valid when the instance stops meanwhile
+	///
+	QMap<quint8, InstanceMetrics> getInstanceMetrics() const;
+
 public slots:
 	///
 	/// @brief Is given instance running?
@@ -180,4 +197,8 @@ private:
 	const QString _rootPath;
 	QMap<quint8, Hyperion*> _runningInstances;
 	QList<quint8> _startQueue;
+
+	/// metrics of the running instances, guarded by _metricsMutex as they are read from other threads
+	mutable QMutex _metricsMutex;
+	QMap<quint8, InstanceMetrics> _instanceMetrics;
 };
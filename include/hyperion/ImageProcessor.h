@@ -9,6 +9,7 @@
 #include <hyperion/LedString.h>
 #include <hyperion/ImageToLedsMap.h>
 #include <utils/Logger.h>
+#include <utils/PipelineMetrics.h>
 
 // settings
 #include <utils/settings.h>
@@ -115,7 +116,11 @@ public:
 			setSize(image);
 
 			// Check black border detection
-			verifyBorder(image);
+			{
+				PipelineStageTimer borderTimer(_metrics, PipelineMetrics::BORDER_DETECT);
+				verifyBorder(image);
+			}
+			PipelineStageTimer mapTimer(_metrics, PipelineMetrics::MAP);
 
 			// Create a result vector and call the 'in place' functionl
 			switch (_mappingType)
@@ -148,7 +153,11 @@ public:
 			setSize(image);
 
 			// Check black border detection
-			verifyBorder(image);
+			{
+				PipelineStageTimer borderTimer(_metrics, PipelineMetrics::BORDER_DETECT);
+				verifyBorder(image);
+			}
+			PipelineStageTimer mapTimer(_metrics, PipelineMetrics::MAP);
 
 			// Determine the mean or uni colors of each led (using the existing mapping)
 			switch (_mappingType)
@@ -237,4 +246,7 @@ private:
 
 	/// Hyperion instance pointer
 	Hyperion* _hyperion;
+
+	/// Metrics of the Hyperion instance to record border detection and mapping to
+	PipelineMetrics* _metrics;
 };
@@ -13,6 +13,7 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonDocument>
+#include <QMutex>
 
 // Utils includes
 #include <utils/ColorRgb.h>
@@ -26,8 +27,9 @@
 
 // Forward declaration
 class Hyperion;
-class QTcpSocket;
+class QThread;
 class FlatBufferConnection;
+class JsonForwardConnection;
 
 class MessageForwarder : public QObject
 {
@@ -39,6 +41,12 @@ public:
 	void addJsonSlave(const QString& slave);
 	void addFlatbufferSlave(const QString& slave);
 
+	///
+	/// @brief Statistics of the json targets, can be called from any thread
+	/// @return Object with one entry per target (connected state, sent/dropped messages, reply latency)
+	///
+	QJsonObject getStatistics() const;
+
 private slots:
 	///
 	/// @brief Handle settings update from Hyperion Settingsmanager emit or this constructor
@@ -72,14 +80,12 @@ private slots:
 	///
 	void forwardFlatbufferMessage(const QString& name, const Image<ColorRgb> &image);
 
+private:
 	///
-	/// @brief Forward message to a single json slave
-	/// @param message The JSON message to send
-	/// @param socket The TCP-Socket with the connection to the slave
+	/// @brief Stop and delete all json connections
 	///
-	void sendJsonMessage(const QJsonObject &message, QTcpSocket *socket);
+	void clearJsonConnections();
 
-private:
 	/// Hyperion instance
 	Hyperion *_hyperion;
 
@@ -91,6 +97,12 @@ private:
 
 	// JSON connection for forwarding
 	QStringList   _jsonSlaves;
+	/// guarded by _jsonConnectionsMutex, getStatistics() reads it from other threads
+	QList<JsonForwardConnection*> _jsonConnections;
+	mutable QMutex _jsonConnectionsMutex;
+
+	/// Thread the json connections are running in
+	QThread* _forwardThread;
 
 	/// Proto connection for forwarding
 	QStringList _flatSlaves;
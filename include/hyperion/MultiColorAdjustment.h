@@ -7,6 +7,7 @@
 
 // Hyperion includes
 #include <utils/ColorRgb.h>
+#include <utils/ColorRgb16.h>
 #include <hyperion/ColorAdjustment.h>
 
 ///
@@ -54,6 +55,15 @@ public:
 	///
 	void applyAdjustment(std::vector<ColorRgb>& ledColors);
 
+	///
+	/// Performs the color adjustment from raw-color to led-color with 16 bit precision,
+	/// the fractions of the adjusted values are kept for dithering by the device
+	///
+	/// @param ledColors The list with raw colors
+	/// @param adjustedColors The list the adjusted colors are written to, resized to the raw colors
+	///
+	void applyAdjustment(const std::vector<ColorRgb>& ledColors, std::vector<ColorRgb16>& adjustedColors);
+
 private:
 	/// List with transform ids
 	QStringList _adjustmentIds;
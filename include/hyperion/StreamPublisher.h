@@ -0,0 +1,144 @@
+#pragma once
+
+// STL includes
+#include <atomic>
+
+// Qt includes
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QWeakPointer>
+#include <QList>
+
+// utils includes
+#include <utils/Image.h>
+#include <utils/ColorRgb.h>
+
+class Hyperion;
+class QThread;
+
+///
+/// @brief A subscription of a live image stream, created by StreamPublisher::subscribe()
+///
+/// The subscription lives in the thread of the subscriber and holds just the latest frame. When the subscriber
+/// does not keep up, older frames are replaced instead of queued. The subscriber keeps the only strong
+/// reference, dropping it ends the subscription.
+///
+class StreamSubscription : public QObject
+{
+	Q_OBJECT
+
+public:
+	enum Format
+	{
+		/// jpg as base64 data url, for JSON messages
+		JPG_DATAURL,
+		/// raw RGB rows
+		RGB,
+		/// jpg file
+		JPG
+	};
+
+	StreamSubscription(Format format, int width, int interval);
+
+	Format format() const { return _format; }
+	int width() const { return _width; }
+	int interval() const { return _interval; }
+
+signals:
+	///
+	/// @brief Emits in the thread of the subscriber with the latest encoded frame
+	/// @param frame   The encoded frame, shared with all other subscribers of the same format and width
+	/// @param width   The image width
+	/// @param height  The image height
+	///
+	void frameReady(const QByteArray& frame, int width, int height);
+
+private slots:
+	void deliver();
+
+private:
+	friend class StreamPublisher;
+
+	///
+	/// @brief Check if the subscription wants a new frame, called by the publisher
+	///
+	bool isDue();
+
+	///
+	/// @brief Offer a new frame, replaces a pending one which was not delivered yet
+	///
+	void offer(const QByteArray& frame, int width, int height);
+
+	const Format _format;
+	const int _width;
+	const int _interval;
+
+	/// publisher thread only
+	QElapsedTimer _lastFrame;
+
+	QMutex _mutex;
+	QByteArray _frame;
+	int _frameWidth;
+	int _frameHeight;
+	std::atomic<bool> _pending;
+};
+
+///
+/// @brief Encode the live image of an instance once per frame and fan it out to all stream subscribers
+///
+/// Every distinct format/width combination is encoded once, and only when at least one of its subscribers
+/// is due according to its interval. All subscribers share the same immutable buffer.
+/// Downscaling and encoding run in the publisher's own thread, so they do not delay the LED output of the instance.
+/// An image which arrives while the previous one is encoded replaces any image not encoded yet.
+///
+class StreamPublisher : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @brief Constructor, the publisher runs in its own thread and has to be deleted by the owner
+	/// @param hyperion  The instance whose images are published
+	///
+	StreamPublisher(Hyperion* hyperion);
+	~StreamPublisher() override;
+
+	///
+	/// @brief Subscribe to the live image stream, thread-safe
+	/// @param format    The encoding
+	/// @param width     Images are downscaled to this width
+	/// @param interval  The minimum time between two frames in ms
+	/// @return The subscription, connect to StreamSubscription::frameReady. Drop it to unsubscribe
+	///
+	QSharedPointer<StreamSubscription> subscribe(StreamSubscription::Format format, int width, int interval);
+
+private slots:
+	///
+	/// @brief Encode the latest image for all due subscribers, runs in the publisher's thread
+	///
+	void encodeLatestImage();
+
+private:
+	///
+	/// @brief Hand over a new image, called in the thread of the instance
+	///
+	void offerImage(const Image<ColorRgb>& image);
+
+	///
+	/// @brief Downscale an image with nearest neighbour sampling
+	/// @return RGB rows of the given size
+	///
+	static QByteArray downscale(const Image<ColorRgb>& image, int width, int height);
+
+	QThread* _thread;
+
+	QMutex _mutex;
+	QList<QWeakPointer<StreamSubscription>> _subscriptions;
+
+	/// the latest image which is not encoded yet, guarded by _mutex
+	Image<ColorRgb> _latestImage;
+	std::atomic<bool> _isEncodePending;
+};
@@ -9,19 +9,25 @@
 #include <QJsonDocument>
 #include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
+#include <QMutex>
 
 // STL includes
 #include <vector>
 #include <map>
 #include <algorithm>
+#include <atomic>
 
 // Utility includes
 #include <utils/ColorRgb.h>
+#include <utils/ColorRgb16.h>
 #include <utils/ColorRgbw.h>
 #include <utils/RgbToRgbw.h>
 #include <utils/Logger.h>
 #include <functional>
 #include <utils/Components.h>
+#include <utils/PipelineMetrics.h>
+#include <leddevice/TemporalDither.h>
 
 class LedDevice;
 
@@ -81,6 +87,40 @@ public:
 	///
 	void setLatchTime(int latchTime_ms);
 
+	///
+	/// @brief Set the metrics the duration of LED updates is recorded to.
+	///
+	/// @param[in] metrics The metrics of the owning instance, nullptr to disable recording
+	///
+	void setMetrics(PipelineMetrics* metrics) { _metrics = metrics; }
+
+	///
+	/// @brief Hand over new LED values to the output loop.
+	///
+	/// Only the latest values are kept, values which were not written yet are replaced.
+	/// @note Can be called from outside the device's thread
+	///
+	/// @param[in] ledValues The color per LED
+	///
+	void submitFrame(const std::vector<ColorRgb>& ledValues);
+
+	///
+	/// @brief Hand over new LED values with 16 bit precision to the output loop.
+	///
+	/// The output loop dithers the values to 8 bit and writes them in every interval, even without new values.
+	/// @note Can be called from outside the device's thread
+	///
+	/// @param[in] ledValues The color per LED
+	///
+	void submitFrame16(const std::vector<ColorRgb16>& ledValues);
+
+	///
+	/// @brief Write the values handed over last via submitFrame() or submitFrame16(), called by the output loop in the device's thread.
+	///
+	/// @return True, if values were written
+	///
+	bool writeLatestFrame();
+
 	///
 	/// @brief Discover devices of this type available (for configuration).
 	/// @note Mainly used for network devices. Allows to find devices, e.g. via ssdp, mDNS or cloud ways.
@@ -172,6 +212,16 @@ public slots:
 	///
 	virtual int updateLeds(const std::vector<ColorRgb>& ledValues);
 
+	///
+	/// @brief Update the color values of the device's LEDs with 16 bit precision.
+	///
+	/// Without an output rate writes happen at an irregular rate, the values are rounded to 8 bit instead of being dithered.
+	///
+	/// @param[in] ledValues The color per LED
+	/// @return Zero on success else negative (i.e. device is not ready)
+	///
+	int updateLeds16(const std::vector<ColorRgb16>& ledValues);
+
 	///
 	/// @brief Enables/disables the device for output.
 	///
@@ -207,6 +257,15 @@ public slots:
 	///
 	QString getColorOrder() const { return _colorOrder; }
 
+	///
+	/// @brief Get the duration of the last LED update written to the device.
+	///
+	/// @note Can be called from outside the device's thread
+	///
+	/// @return Write duration in microseconds
+	///
+	qint64 getLastWriteDuration() const { return _lastWriteDuration_us.load(std::memory_order_relaxed); }
+
 	///
 	/// @brief Get the LED-Device component's state.
 	///
@@ -384,9 +443,23 @@ protected:
 	/// Is the device in the switchOff process?
 	bool _isInSwitchOff;
 
+	/// Is the current write a refresh or black at switch-off, which has to be sent completely?
+	bool _isRefreshWrite;
+
 	/// Timestamp of last write
 	QDateTime _lastWriteTime;
 
+	///
+	/// @brief Count a frame the device dropped, e.g. as its link was still busy with the previous one
+	///
+	void countDroppedFrame()
+	{
+		if ( _metrics != nullptr )
+		{
+			_metrics->increment(PipelineMetrics::DEVICE_DROPPED_FRAMES);
+		}
+	}
+
 protected slots:
 
 	///
@@ -411,15 +484,54 @@ private:
 	/// @brief Stop refresh cycle
 	void stopRefreshTimer();
 
+	///
+	/// @brief Write the values to the device and record the write duration
+	///
+	/// @param[in] ledValues The color per LED
+	/// @return Zero on success else negative
+	///
+	int writeFrame(const std::vector<ColorRgb>& ledValues);
+
+	///
+	/// @brief Dither the 16 bit values to 8 bit, see TemporalDither
+	///
+	/// @return The 8 bit values to be written next
+	///
+	const std::vector<ColorRgb>& ditherFrame();
+
 	/// Is last write refreshing enabled?
 	bool	_isRefreshEnabled;
 
+	/// Skip writes of values identical to the last ones, the refresh time acts as keep-alive
+	bool	_isSkipUnchanged;
+
 	/// Order of Colors supported by the device
 	/// "RGB", "BGR", "RBG", "BRG", "GBR", "GRB"
 	QString	_colorOrder;
 
 	/// Last LED values written
 	std::vector<ColorRgb> _lastLedValues;
+
+	/// Duration of the last write in microseconds
+	std::atomic<qint64> _lastWriteDuration_us;
+
+	/// Monotonic time since the last write, for the latch time
+	QElapsedTimer _latchTimer;
+
+	/// Latest values handed over via submitFrame() and the values the output loop is writing
+	QMutex _frameMutex;
+	std::vector<ColorRgb> _submittedFrame;
+	std::vector<ColorRgb> _outputFrame;
+	bool _isFrameSubmitted;
+	std::vector<ColorRgb16> _submittedFrame16;
+	bool _isFrameSubmitted16;
+
+	/// The 16 bit values to be dithered, empty if the values are 8 bit
+	std::vector<ColorRgb16> _ditherTarget;
+	TemporalDither _dither;
+
+	/// Metrics of the owning instance
+	PipelineMetrics* _metrics;
 };
 
 #endif // LEDEVICE_H
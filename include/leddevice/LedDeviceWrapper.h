@@ -4,6 +4,7 @@
 // util
 #include <utils/Logger.h>
 #include <utils/ColorRgb.h>
+#include <utils/ColorRgb16.h>
 #include <utils/Components.h>
 
 #include <QMutex>
@@ -57,6 +58,13 @@ public:
 	///
 	QString getActiveDeviceType() const;
 
+	///
+	/// @brief Get the duration of the last write of the ledDevice, does not block the device thread
+	/// @note Can be called from any thread
+	/// @return write duration in us
+	///
+	qint64 getLastWriteDuration() const;
+
 	///
 	/// @brief Return the last enable state
 	///
@@ -90,6 +98,15 @@ signals:
 	///
 	int updateLeds(const std::vector<ColorRgb>& ledValues);
 
+	///
+	/// PIPER signal for Hyperion -> LedDevice with 16 bit precision, dithered to 8 bit by the LedDevice
+	///
+	/// @param[in] ledValues  The RGB-color per led
+	///
+	/// @return Zero on success else negative
+	///
+	int updateLeds16(const std::vector<ColorRgb16>& ledValues);
+
 	void setEnable(bool enable);
 	void closeLedDevice();
 
@@ -118,6 +135,8 @@ private:
 	Hyperion* _hyperion;
 	// Pointer of current led device
 	LedDevice* _ledDevice;
+	// guards replacing _ledDevice against getLastWriteDuration() called from other threads
+	mutable QMutex _ledDeviceLock;
 	// the enable state
 	bool _enabled;
 };
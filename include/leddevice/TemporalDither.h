@@ -0,0 +1,41 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+#include <vector>
+
+// Utility includes
+#include <utils/ColorRgb.h>
+#include <utils/ColorRgb16.h>
+
+///
+/// @brief Reduces 16 bit colors to 8 bit by temporal dithering (first order error diffusion over time)
+///
+/// The fraction of every channel not written is carried over to the next frame, so the average of the written
+/// values approaches the 16 bit values. The 16 bit value x * 257 is the 8 bit value x, which is written unchanged.
+///
+class TemporalDither
+{
+public:
+	///
+	/// @brief Dither the values of the next frame
+	///
+	/// @param[in] values The 16 bit color per LED
+	/// @return The 8 bit color per LED, valid until the next call
+	///
+	const std::vector<ColorRgb>& dither(const std::vector<ColorRgb16>& values);
+
+	///
+	/// @brief Round the values to the nearest 8 bit values, for writes at an irregular rate which must not flicker
+	///
+	/// @param[in] values The 16 bit color per LED
+	/// @return The 8 bit color per LED, valid until the next call
+	///
+	const std::vector<ColorRgb>& round(const std::vector<ColorRgb16>& values);
+
+private:
+	/// The fraction per channel not yet written, in 1/257 of an 8 bit step
+	std::vector<uint16_t> _error;
+	/// The dithered values
+	std::vector<ColorRgb> _frame;
+};
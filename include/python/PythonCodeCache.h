@@ -0,0 +1,50 @@
+#pragma once
+
+// Python includes
+// collide of qt slots macro
+#undef slots
+#include "Python.h"
+#define slots
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QString>
+
+class Logger;
+
+///
+/// @brief Process wide cache of compiled effect scripts
+///
+/// Scripts are compiled once and kept as marshalled bytecode keyed by path, modification time and size.
+/// Unmarshalling into the current interpreter is much faster than reading and compiling the source again
+/// and code objects are never shared between interpreters.
+///
+class PythonCodeCache
+{
+public:
+	///
+	/// @brief Load the compiled code of a script into the current interpreter, the GIL must be held
+	/// @param script The path of the script
+	/// @param log    The logger to report a missing script to
+	/// @return New reference to the code object, nullptr on failure (a Python error is set on compile errors)
+	///
+	static PyObject* load(const QString& script, Logger* log);
+
+	///
+	/// @brief Drop all cached scripts
+	///
+	static void clear();
+
+private:
+	struct Entry
+	{
+		QDateTime lastModified;
+		qint64 size;
+		QByteArray bytecode;
+	};
+
+	static QMutex _mutex;
+	static QHash<QString, Entry> _entries;
+};
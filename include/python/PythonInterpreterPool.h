@@ -0,0 +1,84 @@
+#pragma once
+
+// Python includes
+// collide of qt slots macro
+#undef slots
+#include "Python.h"
+#define slots
+
+#include <QList>
+#include <QMap>
+#include <QSet>
+#include <QString>
+
+///
+/// @brief Pool of warm Python sub-interpreters which are reused between effect runs
+///
+/// Creating a sub-interpreter and importing the standard modules takes several hundred milliseconds on slow devices.
+/// Instead of ending the interpreter after an effect has finished, it is parked for the next effect.
+/// A thread state is only made current on the thread which created it, a user attaches its own thread state to a parked
+/// interpreter. A parked interpreter holds a keeper thread state which is never made current, as an interpreter must
+/// not run out of thread states. Before an interpreter is reused the modules imported by the previous effect are dropped and the
+/// __main__ and hyperion modules are created again.
+/// All methods must be called while holding the GIL, which also serializes the access to the pool.
+///
+class PythonInterpreterPool
+{
+public:
+	///
+	/// @brief Get an idle interpreter or create a new one and attach a thread state of the calling thread
+	/// @return The thread state, which is the current one, nullptr on failure
+	///
+	static PyThreadState* acquire();
+
+	///
+	/// @brief Delete the thread state of a finished user and park its interpreter for reuse.
+	///        When the pool is full the interpreter is ended. The current thread state is unset afterwards.
+	/// @param tstate The current thread state of the user, other threads of the interpreter must be finished
+	///
+	static void release(PyThreadState* tstate);
+
+	///
+	/// @brief Create interpreters in advance and import commonly used modules
+	/// @param count The number of interpreters to create
+	///
+	static void prewarm(int count);
+
+	///
+	/// @brief End all idle interpreters, called before Python is finalized
+	///
+	static void clear();
+
+private:
+	///
+	/// @brief Create an interpreter with the commonly used modules imported
+	/// @return The thread state of the new interpreter, which is the current one, nullptr on failure
+	///
+	static PyThreadState* createInterpreter();
+
+	///
+	/// @brief Delete the current thread state and add its interpreter with a keeper thread state to the idle ones
+	///
+	static void park(PyThreadState* tstate);
+
+	///
+	/// @brief Delete the keeper thread state of an interpreter taken from the idle ones
+	///
+	static void dropKeeper(PyInterpreterState* interp);
+
+	///
+	/// @brief Drop the modules imported since the interpreter was created and create new __main__ and hyperion modules
+	/// @param baseline The names of the modules loaded when the interpreter was created
+	///
+	static void resetInterpreter(const QSet<QString>& baseline);
+
+	/// Maximum number of idle interpreters
+	static constexpr int MAX_IDLE = 4;
+
+	/// The modules loaded when the interpreter was created, they are kept on reuse
+	static QMap<PyInterpreterState*, QSet<QString>> _baselineModules;
+	/// The thread state which keeps an idle interpreter alive
+	static QMap<PyInterpreterState*, PyThreadState*> _keepers;
+	/// The interpreters which are ready to use
+	static QList<PyInterpreterState*> _idle;
+};
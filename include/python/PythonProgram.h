@@ -17,9 +17,23 @@ public:
 	PythonProgram(const QString & name, Logger * log);
 	~PythonProgram();
 
+	///
+	/// @brief Execute python source code in the __main__ namespace
+	/// @param python_code The source code
+	///
 	void execute(const QByteArray &python_code);
 
+	///
+	/// @brief Execute a script file in the __main__ namespace, the compiled code is cached by PythonCodeCache
+	/// @param script The path of the script
+	/// @return False if the script could not be loaded
+	///
+	bool executeScript(const QString &script);
+
 private:
+	void execute(PyObject *code);
+	void handleError();
+
 	QString _name;
 	Logger* _log;
 	PyThreadState* _tstate;
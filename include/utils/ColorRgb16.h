@@ -0,0 +1,69 @@
+#pragma once
+
+// STL includes
+#include <cstdint>
+#include <iostream>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+
+///
+/// Plain-Old-Data structure containing the red-green-blue color specification with 16 bit per channel.
+/// Used by the high precision pipeline, the 8 bit value x corresponds to the 16 bit value x * 257.
+///
+struct ColorRgb16
+{
+	/// The red color channel
+	uint16_t red;
+	/// The green color channel
+	uint16_t green;
+	/// The blue color channel
+	uint16_t blue;
+
+	/// The 16 bit value of an 8 bit channel value
+	static uint16_t fromChannel8(uint8_t value)
+	{
+		return static_cast<uint16_t>(value * 257);
+	}
+
+	/// The 16 bit color of an 8 bit color
+	static ColorRgb16 fromRgb(const ColorRgb & color)
+	{
+		return { fromChannel8(color.red), fromChannel8(color.green), fromChannel8(color.blue) };
+	}
+};
+
+/// Assert to ensure that the size of the structure is 'only' 6 bytes
+static_assert(sizeof(ColorRgb16) == 6, "Incorrect size of ColorRgb16");
+
+///
+/// Stream operator to write ColorRgb16 to an outputstream (format "'{'[red]','[green]','[blue]'}'")
+///
+/// @param os The output stream
+/// @param color The color to write
+/// @return The output stream (with the color written to it)
+///
+inline std::ostream& operator<<(std::ostream& os, const ColorRgb16& color)
+{
+	os << "{"
+		<< color.red   << ","
+		<< color.green << ","
+		<< color.blue  <<
+	"}";
+
+	return os;
+}
+
+/// Compare operator to check if a color is 'equal' to another color
+inline bool operator==(const ColorRgb16 & lhs, const ColorRgb16 & rhs)
+{
+	return	lhs.red   == rhs.red   &&
+		lhs.green == rhs.green &&
+		lhs.blue  == rhs.blue;
+}
+
+/// Compare operator to check if a color is 'not equal' to another color
+inline bool operator!=(const ColorRgb16 & lhs, const ColorRgb16 & rhs)
+{
+	return !(lhs == rhs);
+}
@@ -186,6 +186,16 @@ public:
 		_d_ptr->clear();
 	}
 
+	///
+	/// Check if the pixel data is shared with copies of this image, writing to a shared image detaches it
+	///
+	/// @return True if other copies reference the same pixel data
+	///
+	bool isShared() const
+	{
+		return _d_ptr.constData()->ref.load() > 1;
+	}
+
 private:
 	template<class T>
 	friend class Image;
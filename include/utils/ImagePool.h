@@ -0,0 +1,64 @@
+#pragma once
+
+// STL includes
+#include <deque>
+
+// utils includes
+#include <utils/Image.h>
+
+///
+/// @brief Recycles the pixel buffers of images which are handed over to other threads
+///
+/// An image passed on (e.g. to the muxer) shares its pixel data with the pool until all copies are gone.
+/// acquire() returns an image nobody else references, so writing to it neither detaches nor allocates.
+/// The pool is meant to be used by a single thread, the images may be released from any thread.
+///
+template <typename Pixel_T>
+class ImagePool
+{
+public:
+	///
+	/// @param maxSize  The maximum number of images kept for reuse
+	///
+	explicit ImagePool(unsigned maxSize = 4)
+		: _maxSize(maxSize)
+		, _next(0)
+	{
+	}
+
+	///
+	/// @brief Get an image which is not referenced outside of the pool
+	/// @param width   The image width
+	/// @param height  The image height
+	/// @return The image with undefined content, valid until the next call of acquire()
+	///
+	Image<Pixel_T>& acquire(unsigned width, unsigned height)
+	{
+		for (auto& image : _images)
+		{
+			if (!image.isShared())
+			{
+				image.resize(width, height);
+				return image;
+			}
+		}
+
+		if (_images.size() < _maxSize)
+		{
+			_images.emplace_back(width, height);
+			return _images.back();
+		}
+
+		// all images are still in use, hand the oldest over to its users and replace it
+		Image<Pixel_T>& image = _images[_next];
+		_next = (_next + 1) % _maxSize;
+		Image<Pixel_T> replacement(width, height);
+		image.swap(replacement);
+		return image;
+	}
+
+private:
+	const unsigned _maxSize;
+	unsigned _next;
+	std::deque<Image<Pixel_T>> _images;
+};
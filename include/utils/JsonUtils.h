@@ -3,6 +3,7 @@
 #include <utils/FileUtils.h>
 
 #include <QJsonObject>
+#include <QByteArray>
 #include <utils/Logger.h>
 
 namespace JsonUtils {
@@ -55,6 +56,26 @@ namespace JsonUtils {
 	///
 	bool parse(const QString& path, const QString& data, QJsonDocument& doc, Logger* log);
 
+	///
+	/// @brief parse utf8 encoded json data and get a QJsonObject, avoids the conversion to QString. Overloaded function
+	/// @param[in]  path     The file path/name just used for log messages
+	/// @param[in]  data     Data to parse
+	/// @param[out] obj      Retuns the parsed QJsonObject
+	/// @param[in]  log      The logger of the caller to print errors
+	/// @return              true on success else false
+	///
+	bool parse(const QString& path, const QByteArray& data, QJsonObject& obj, Logger* log);
+
+	///
+	/// @brief parse utf8 encoded json data and get a QJsonDocument
+	/// @param[in]  path     The file path/name just used for log messages
+	/// @param[in]  data     Data to parse
+	/// @param[out] doc      Retuns the parsed QJsonDocument
+	/// @param[in]  log      The logger of the caller to print errors
+	/// @return              true on success else false
+	///
+	bool parse(const QString& path, const QByteArray& data, QJsonDocument& doc, Logger* log);
+
 	///
 	/// @brief Validate json data against a schema
 	/// @param[in]   file     The path/name of json file just used for log messages
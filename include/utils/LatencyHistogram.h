@@ -0,0 +1,84 @@
+#pragma once
+
+// STL includes
+#include <atomic>
+#include <array>
+#include <cstdint>
+
+// Qt includes
+#include <QJsonObject>
+
+///
+/// @brief Lock-free latency histogram with HDR-style log-linear buckets
+///
+/// Values are recorded in microseconds. Values below 16us are counted exactly, every further power of two
+/// is split into 8 linear sub-buckets which limits the relative error of a percentile to 12.5%.
+/// Recording is wait-free and may happen from any thread, reading is possible concurrently.
+///
+class LatencyHistogram
+{
+public:
+	LatencyHistogram();
+
+	///
+	/// @brief Record a single value
+	/// @param value_us The value in microseconds, negative values are recorded as zero
+	///
+	void record(int64_t value_us);
+
+	///
+	/// @brief Reset all counters
+	///
+	void reset();
+
+	///
+	/// @brief Get the number of recorded values
+	///
+	uint64_t count() const { return _count.load(std::memory_order_relaxed); }
+
+	///
+	/// @brief Get the largest recorded value
+	///
+	int64_t max() const { return _max.load(std::memory_order_relaxed); }
+
+	///
+	/// @brief Get the sum of all recorded values
+	///
+	uint64_t sum() const { return _sum.load(std::memory_order_relaxed); }
+
+	///
+	/// @brief Get the mean of all recorded values
+	///
+	double mean() const;
+
+	///
+	/// @brief Get the value at the given percentile
+	/// @param percentile The percentile [0.0 .. 100.0]
+	/// @return The upper bound of the bucket the percentile falls in (in us)
+	///
+	int64_t percentile(double percentile) const;
+
+	///
+	/// @brief Summary as JSON (count, mean, p50, p90, p99, max)
+	///
+	QJsonObject toJson() const;
+
+private:
+	/// Number of exactly counted values
+	static constexpr int LINEAR_BUCKETS = 16;
+	/// Number of sub-buckets for every power of two
+	static constexpr int SUB_BUCKETS = 8;
+	/// log2(SUB_BUCKETS)
+	static constexpr int SUB_BUCKET_BITS = 3;
+	/// Values up to 2^36us (~19h) are distinguished, larger ones are saturated
+	static constexpr int MAX_EXPONENT = 36;
+	static constexpr int BUCKET_COUNT = LINEAR_BUCKETS + (MAX_EXPONENT - 4) * SUB_BUCKETS;
+
+	static int bucketIndex(uint64_t value);
+	static int64_t bucketUpperBound(int index);
+
+	std::array<std::atomic<uint64_t>, BUCKET_COUNT> _buckets;
+	std::atomic<uint64_t> _count;
+	std::atomic<uint64_t> _sum;
+	std::atomic<int64_t>  _max;
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+// STL includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Qt includes
+#include <QString>
+#include <QJsonObject>
+
+#include <utils/LatencyHistogram.h>
+
+///
+/// @brief Always available, low overhead latency instrumentation of the processing pipeline
+///
+/// Every stage owns a lock-free LatencyHistogram, stages can be recorded from any thread.
+/// The capture stages (grab, resample) are shared by all instances and recorded to PipelineMetrics::capture(),
+/// each Hyperion instance holds its own metrics for the remaining stages.
+/// Additionally a set of monotonic counters and gauges is kept, which is not affected by reset().
+///
+class PipelineMetrics
+{
+public:
+	enum Stage
+	{
+		GRAB,
+		RESAMPLE,
+		BORDER_DETECT,
+		MAP,
+		ADJUST,
+		SMOOTH,
+		DEVICE_WRITE,
+		LATENCY,
+		SMOOTH_JITTER,
+		STAGE_COUNT
+	};
+
+	enum Counter
+	{
+		FRAMES_RENDERED,
+		FRAMES_SKIPPED,
+		DEVICE_WRITE_ERRORS,
+		ACTIVE_EFFECTS,
+		DEVICE_MISSED_DEADLINES,
+		DEVICE_DROPPED_FRAMES,
+		COUNTER_COUNT
+	};
+
+	///
+	/// @brief Convert a stage to its string representation
+	/// @param  stage The stage from enum
+	/// @return       The stage as string
+	///
+	static QString stageToString(Stage stage);
+
+	///
+	/// @brief Convert a counter to its string representation
+	/// @param  counter The counter from enum
+	/// @return         The counter as string
+	///
+	static QString counterToString(Counter counter);
+
+	///
+	/// @brief Process wide metrics of the capture stages, which are shared by all instances
+	///
+	static PipelineMetrics& capture();
+
+	///
+	/// @brief Monotonic timestamp to measure stage durations with
+	/// @return Timestamp in microseconds
+	///
+	static int64_t now_us();
+
+	///
+	/// @brief Record the duration of a stage
+	/// @param stage        The stage from enum
+	/// @param duration_us  The duration in microseconds
+	///
+	void record(Stage stage, int64_t duration_us) { _stages[stage].record(duration_us); }
+
+	///
+	/// @brief Get the histogram of a stage
+	///
+	LatencyHistogram& histogram(Stage stage) { return _stages[stage]; }
+	const LatencyHistogram& histogram(Stage stage) const { return _stages[stage]; }
+
+	///
+	/// @brief Increase a counter
+	/// @param counter  The counter from enum
+	/// @param value    The value to add
+	///
+	void increment(Counter counter, int64_t value = 1) { _counters[counter].fetch_add(value, std::memory_order_relaxed); }
+
+	///
+	/// @brief Set a gauge to an absolute value
+	/// @param counter  The counter from enum
+	/// @param value    The new value
+	///
+	void set(Counter counter, int64_t value) { _counters[counter].store(value, std::memory_order_relaxed); }
+
+	///
+	/// @brief Get the current value of a counter
+	///
+	int64_t counter(Counter counter) const { return _counters[counter].load(std::memory_order_relaxed); }
+
+	///
+	/// @brief Reset the histograms of all stages, counters are kept
+	///
+	void reset();
+
+	///
+	/// @brief Summary of all stages which recorded at least one value
+	/// @return Object with one summary per stage name
+	///
+	QJsonObject toJson() const;
+
+private:
+	std::array<LatencyHistogram, STAGE_COUNT> _stages;
+	std::array<std::atomic<int64_t>, COUNTER_COUNT> _counters {};
+};
+
+///
+/// @brief Records the lifetime of the scope as duration of a stage
+///
+class PipelineStageTimer
+{
+public:
+	PipelineStageTimer(PipelineMetrics* metrics, PipelineMetrics::Stage stage)
+		: _metrics(metrics)
+		, _stage(stage)
+		, _start(metrics != nullptr ? PipelineMetrics::now_us() : 0)
+	{
+	}
+
+	~PipelineStageTimer()
+	{
+		if (_metrics != nullptr)
+		{
+			_metrics->record(_stage, PipelineMetrics::now_us() - _start);
+		}
+	}
+
+private:
+	PipelineMetrics* _metrics;
+	PipelineMetrics::Stage _stage;
+	int64_t _start;
+};
@@ -35,6 +35,19 @@ public:
 	///
 	void apply(uint8_t input, uint8_t brightness, uint8_t & red, uint8_t & green, uint8_t & blue);
 
+	///
+	/// Transform the given 16 bit value, calculated without the 8 bit mapping
+	///
+	/// @param input The input color value with 16 bit precision
+	/// @param brightness The current brightness value
+	/// @param red The red color component
+	/// @param green The green color component
+	/// @param blue The blue color component
+	///
+	/// @note The values are updated in place.
+	///
+	void apply(uint16_t input, uint8_t brightness, uint16_t & red, uint16_t & green, uint16_t & blue) const;
+
 	///
 	/// setAdjustment RGB
 	///
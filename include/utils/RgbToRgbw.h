@@ -1,6 +1,9 @@
 #pragma once
 #include <QString>
 
+// STL includes
+#include <vector>
+
 #include <utils/ColorRgb.h>
 #include <utils/ColorRgbw.h>
 
@@ -11,9 +14,21 @@ namespace RGBW {
 		SUBTRACT_MINIMUM,
 		SUB_MIN_WARM_ADJUST,
 		SUB_MIN_COOL_ADJUST,
+		SUB_MIN_CUSTOM_ADJUST,
 		WHITE_OFF
 	};
 
 	WhiteAlgorithm stringToWhiteAlgorithm(const QString& str);
-	void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm);
+	void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm, const ColorRgb& whiteLedColor = ColorRgb::WHITE);
+
+	///
+	/// @brief Convert all colors of a frame, the algorithm is selected once for the whole frame
+	///
+	/// @param[in]  input         The RGB colors
+	/// @param[out] output        The RGBW colors, resized to the number of input colors if required
+	/// @param[in]  algorithm     The white algorithm
+	/// @param[in]  whiteLedColor The color of the white LED in terms of the RGB LEDs (SUB_MIN_CUSTOM_ADJUST),
+	///                           e.g. a warm white LED has less blue than (255,255,255)
+	///
+	void Rgb_to_Rgbw(const std::vector<ColorRgb>& input, std::vector<ColorRgbw>& output, WhiteAlgorithm algorithm, const ColorRgb& whiteLedColor = ColorRgb::WHITE);
 }
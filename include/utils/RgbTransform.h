@@ -92,6 +92,19 @@ public:
 	///
 	void transform(uint8_t & red, uint8_t & green, uint8_t & blue);
 
+	///
+	/// Apply the transform the the given RGB values with 16 bit precision.
+	/// The backlight uses the same whole-numbered scaling as the 8 bit transform.
+	///
+	/// @param red The red color component
+	/// @param green The green color component
+	/// @param blue The blue color component
+	/// @param red16 The transformed red color component
+	/// @param green16 The transformed green color component
+	/// @param blue16 The transformed blue color component
+	///
+	void transform(uint8_t red, uint8_t green, uint8_t blue, uint16_t & red16, uint16_t & green16, uint16_t & blue16) const;
+
 private:
 	///
 	/// init
@@ -127,6 +140,11 @@ private:
 		, _mappingG[256]
 		, _mappingB[256];
 
+	/// The mapping from input color to output color with 16 bit precision
+	uint16_t  _mapping16R[256]
+		, _mapping16G[256]
+		, _mapping16B[256];
+
 	/// brightness variables
 	uint8_t   _brightness
 		, _brightnessCompensation
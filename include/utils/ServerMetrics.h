@@ -0,0 +1,74 @@
+#pragma once
+
+// STL includes
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// Qt includes
+#include <QString>
+
+///
+/// @brief Process wide connection and traffic counters of the network servers
+///
+/// All methods are static and lock-free, the servers update them from their own threads.
+///
+class ServerMetrics
+{
+public:
+	enum Server
+	{
+		FLATBUFSERVER,
+		PROTOSERVER,
+		JSONSERVER,
+		SERVER_COUNT
+	};
+
+	///
+	/// @brief Convert a server to its string representation
+	/// @param  server The server from enum
+	/// @return        The server as string
+	///
+	static QString serverToString(Server server);
+
+	///
+	/// @brief Set the number of currently connected clients of a server
+	/// @param server   The server from enum
+	/// @param clients  The number of clients
+	///
+	static void setClients(Server server, int64_t clients) { _clients[server].store(clients, std::memory_order_relaxed); }
+
+	///
+	/// @brief Add the number of bytes received by a server
+	/// @param server   The server from enum
+	/// @param bytes    The number of bytes
+	///
+	static void addReceivedBytes(Server server, int64_t bytes) { _receivedBytes[server].fetch_add(bytes, std::memory_order_relaxed); }
+
+	///
+	/// @brief Add the number of frames a server dropped, e.g. incomplete or late UDP frames
+	/// @param server   The server from enum
+	/// @param frames   The number of frames
+	///
+	static void addDroppedFrames(Server server, int64_t frames) { _droppedFrames[server].fetch_add(frames, std::memory_order_relaxed); }
+
+	///
+	/// @brief Get the number of currently connected clients of a server
+	///
+	static int64_t clients(Server server) { return _clients[server].load(std::memory_order_relaxed); }
+
+	///
+	/// @brief Get the total number of bytes received by a server
+	///
+	static int64_t receivedBytes(Server server) { return _receivedBytes[server].load(std::memory_order_relaxed); }
+
+	///
+	/// @brief Get the total number of frames dropped by a server
+	///
+	static int64_t droppedFrames(Server server) { return _droppedFrames[server].load(std::memory_order_relaxed); }
+
+private:
+	static std::array<std::atomic<int64_t>, SERVER_COUNT> _clients;
+	static std::array<std::atomic<int64_t>, SERVER_COUNT> _receivedBytes;
+	static std::array<std::atomic<int64_t>, SERVER_COUNT> _droppedFrames;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+///
+/// Selection of the vectorised code paths
+///
+/// x86: The SSSE3 paths are compiled with a target attribute, independent of the build's baseline.
+///      They are used when simd::hasSsse3() detects the instruction set at runtime.
+/// ARM: The NEON paths are compiled when the compiler targets NEON. AArch64 always does; 32 bit ARM builds have to
+///      enable it with the cmake option -DENABLE_NEON=ON, and the binary then requires a CPU with NEON.
+///
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+	#include <tmmintrin.h>
+
+	#define SIMD_SSSE3
+	#define SIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+
+	namespace simd {
+
+	/// @return True, if the CPU supports SSSE3
+	inline bool hasSsse3()
+	{
+		static const bool isSupported = __builtin_cpu_supports("ssse3");
+		return isSupported;
+	}
+
+	}
+#elif defined(__ARM_NEON)
+	#include <arm_neon.h>
+
+	#define SIMD_NEON
+#endif
@@ -1,5 +1,6 @@
 // project includes
 #include <api/JsonAPI.h>
+#include <api/JsonSchemaRegistry.h>
 
 // stl includes
 #include <iostream>
@@ -9,8 +10,6 @@
 #include <QResource>
 #include <QDateTime>
 #include <QCryptographicHash>
-#include <QImage>
-#include <QBuffer>
 #include <QByteArray>
 #include <QTimer>
 #include <QHostInfo>
@@ -23,6 +22,7 @@
 #include <leddevice/LedDeviceFactory.h>
 
 #include <hyperion/GrabberWrapper.h>
+#include <hyperion/MessageForwarder.h>
 #include <utils/jsonschema/QJsonFactory.h>
 #include <utils/jsonschema/QJsonSchemaChecker.h>
 #include <HyperionConfig.h>
@@ -47,6 +47,26 @@
 
 using namespace hyperion;
 
+namespace {
+
+// binary stream (ledcolors binarystream) frame types
+const quint8 BINARY_STREAM_VERSION = 1;
+const quint8 BINARY_LEDS_RAW = 1;
+const quint8 BINARY_LEDS_DELTA = 2;
+const quint8 BINARY_IMAGE_RGB = 3;
+const quint8 BINARY_IMAGE_JPG = 4;
+
+// force a raw led frame after this number of delta frames
+const int BINARY_KEYFRAME_INTERVAL = 100;
+
+void appendUInt16(QByteArray &data, quint16 value)
+{
+	data.append(static_cast<char>(value >> 8));
+	data.append(static_cast<char>(value & 0xFF));
+}
+
+}
+
 JsonAPI::JsonAPI(QString peerAddress, Logger *log, bool localConnection, QObject *parent, bool noListener)
 	: API(log, localConnection, parent)
 /*	, _authManager(AuthManager::getInstance()) // moved to API
@@ -76,7 +96,12 @@ JsonAPI::JsonAPI(QString peerAddress, Logger *log, bool localConnection, QObject
 	_jsonCB = new JsonCB(this);
 	_streaming_logging_activated = false;
 	_ledStreamTimer = new QTimer(this);
+	_binaryStreamingSupported = false;
+	_batchReplies = nullptr;
 	Q_INIT_RESOURCE(JSONRPC_schemas);
+
+	// load all schemas with the first client
+	JsonSchemaRegistry::getInstance();
 }
 
 void JsonAPI::initialize()
@@ -113,18 +138,55 @@ bool JsonAPI::handleInstanceSwitch(quint8 inst, bool forced)
 }
 
 void JsonAPI::handleMessage(const QString &messageString, const QString &httpAuthHeader)
+{
+	handleMessage(messageString.toUtf8(), httpAuthHeader);
+}
+
+void JsonAPI::handleMessage(const QByteArray &messageString, const QString &httpAuthHeader)
 {
 	const QString ident = "JsonRpc@" + _peerAddress;
-	QJsonObject message;
+	QJsonDocument doc;
 	// parse the message
-	if (!JsonUtils::parse(ident, messageString, message, _log))
+	if (!JsonUtils::parse(ident, messageString, doc, _log))
 	{
 		sendErrorReply("Errors during message parsing, please consult the Hyperion Log.");
 		return;
 	}
 
+	if (doc.isArray())
+		handleBatch(doc.array(), httpAuthHeader);
+	else
+		handleCommand(doc.object(), httpAuthHeader);
+}
+
+void JsonAPI::handleBatch(const QJsonArray &batch, const QString &httpAuthHeader)
+{
+	if (batch.isEmpty())
+	{
+		sendErrorReply("Empty batch", "batch");
+		return;
+	}
+
+	QJsonArray replies;
+	_batchReplies = &replies;
+	for (const auto &entry : batch)
+	{
+		handleCommand(entry.toObject(), httpAuthHeader);
+	}
+	_batchReplies = nullptr;
+
+	// the inputs of the batch are coalesced already, apply them with the reply
+	flushPendingInputs();
+	sendSuccessDataReply(QJsonDocument(replies), "batch");
+}
+
+void JsonAPI::handleCommand(const QJsonObject &message, const QString &httpAuthHeader)
+{
+	const QString ident = "JsonRpc@" + _peerAddress;
+
 	// check basic message
-	if (!JsonUtils::validate(ident, message, ":schema", _log))
+	const JsonSchemaRegistry& schemas = JsonSchemaRegistry::getInstance();
+	if (!schemas.validate(ident, message, "schema", _log))
 	{
 		sendErrorReply("Errors during message validation, please consult the Hyperion Log.");
 		return;
@@ -132,7 +194,7 @@ void JsonAPI::handleMessage(const QString &messageString, const QString &httpAut
 
 	// check specific message
 	const QString command = message["command"].toString();
-	if (!JsonUtils::validate(ident, message, QString(":schema-%1").arg(command), _log))
+	if (!schemas.validate(ident, message, "schema-" + command, _log))
 	{
 		sendErrorReply("Errors during specific message validation, please consult the Hyperion Log", command);
 		return;
@@ -161,6 +223,10 @@ void JsonAPI::handleMessage(const QString &messageString, const QString &httpAut
 		return;
 	}
 proceed:
+	// color and image inputs are coalesced, all other commands see them applied
+	if (command != "color" && command != "image")
+		flushPendingInputs();
+
 	// switch over all possible commands and handle them
 	if (command == "color")
 		handleColorCommand(message, command, tan);
@@ -198,6 +264,8 @@ proceed:
 		handleInstanceCommand(message, command, tan);
 	else if (command == "leddevice")
 		handleLedDeviceCommand(message, command, tan);
+	else if (command == "metrics")
+		handleMetricsCommand(message, command, tan);
 
 	// BEGIN | The following commands are derecated but used to ensure backward compatibility with hyperion Classic remote control
 	else if (command == "clearall")
@@ -213,27 +281,27 @@ proceed:
 
 void JsonAPI::handleColorCommand(const QJsonObject &message, const QString &command, int tan)
 {
-	emit forwardJsonMessage(message);
-	int priority = message["priority"].toInt();
-	int duration = message["duration"].toInt(-1);
-	const QString origin = message["origin"].toString("JsonRpc") + "@" + _peerAddress;
+	const int priority = message["priority"].toInt();
+
+	PendingInput input;
+	input.priority = priority;
+	input.message = message;
+	input.duration = message["duration"].toInt(-1);
+	input.origin = message["origin"].toString("JsonRpc") + "@" + _peerAddress;
 
 	const QJsonArray &jsonColor = message["color"].toArray();
-	std::vector<uint8_t> colors;
-	// TODO faster copy
+	input.colors.reserve(jsonColor.size());
 	for (const auto &entry : jsonColor)
 	{
-		colors.emplace_back(uint8_t(entry.toInt()));
+		input.colors.emplace_back(uint8_t(entry.toInt()));
 	}
 
-	API::setColor(priority, colors, duration, origin);
+	queueInput(input);
 	sendSuccessReply(command, tan);
 }
 
 void JsonAPI::handleImageCommand(const QJsonObject &message, const QString &command, int tan)
 {
-	emit forwardJsonMessage(message);
-
 	API::ImageCmdData idata;
 	idata.priority = message["priority"].toInt();
 	idata.origin = message["origin"].toString("JsonRpc") + "@" + _peerAddress;
@@ -244,8 +312,31 @@ void JsonAPI::handleImageCommand(const QJsonObject &message, const QString &comm
 	idata.format = message["format"].toString();
 	idata.imgName = message["name"].toString("");
 	idata.data = QByteArray::fromBase64(QByteArray(message["imagedata"].toString().toUtf8()));
-	QString replyMsg;
 
+	// raw images can be validated upfront and are coalesced like colors
+	if (idata.format != "auto")
+	{
+		if (idata.data.size() != idata.width * idata.height * 3)
+		{
+			sendErrorReply("Size of image data does not match with the width and height", command, tan);
+			return;
+		}
+
+		PendingInput input;
+		input.priority = idata.priority;
+		input.message = message;
+		input.isImage = true;
+		input.image = idata;
+		queueInput(input);
+		sendSuccessReply(command, tan);
+		return;
+	}
+
+	// this image replaces a pending input of the same priority anyway
+	removePendingInput(idata.priority);
+	emit forwardJsonMessage(message);
+
+	QString replyMsg;
 	if (!API::setImage(idata, COMP_IMAGE, replyMsg))
 	{
 		sendErrorReply(replyMsg, command, tan);
@@ -316,7 +407,7 @@ void JsonAPI::handleSysInfoCommand(const QJsonObject &, const QString &command,
 
 	// send the result
 	result["info"] = info;
-	emit callbackMessage(result);
+	sendReply(result);
 }
 
 void JsonAPI::handleServerInfoCommand(const QJsonObject &message, const QString &command, int tan)
@@ -982,6 +1073,13 @@ void JsonAPI::handleLedColorsCommand(const QJsonObject &message, const QString &
 	// create result
 	QString subcommand = message["subcommand"].toString("");
 
+	// the schema allows the 20ms of the binary stream, the json streams keep their minimum of 50ms
+	if ((subcommand == "ledstream-start" || subcommand == "imagestream-start") && message.contains("interval") && message["interval"].toInt() < 50)
+	{
+		sendErrorReply("The interval of " + subcommand + " must be at least 50ms", command + "-" + subcommand, tan);
+		return;
+	}
+
 	// max 20 Hz (50ms) interval for streaming (default: 10 Hz (100ms))
 	qint64 streaming_interval = qMax(message["interval"].toInt(100), 50);
 
@@ -991,30 +1089,59 @@ void JsonAPI::handleLedColorsCommand(const QJsonObject &message, const QString &
 		_streaming_leds_reply["command"] = command + "-ledstream-update";
 		_streaming_leds_reply["tan"] = tan;
 
-		connect(_hyperion, &Hyperion::rawLedColors, this, [=](const std::vector<ColorRgb> &ledValues) {
-			_currentLedValues = ledValues;
-
-			// necessary because Qt::UniqueConnection for lambdas does not work until 5.9
-			// see: https://bugreports.qt.io/browse/QTBUG-52438
-			if (!_ledStreamConnection)
-				_ledStreamConnection = connect(_ledStreamTimer, &QTimer::timeout, this, [=]() {
-					emit streamLedcolorsUpdate(_currentLedValues);
-				},
-											   Qt::UniqueConnection);
-
-			// start the timer
-			if (!_ledStreamTimer->isActive() || _ledStreamTimer->interval() != streaming_interval)
-				_ledStreamTimer->start(streaming_interval);
-		},
-				Qt::UniqueConnection);
-		// push once
-		_hyperion->update();
+		_binaryStream.leds = false;
+		startLedStream(streaming_interval);
 	}
 	else if (subcommand == "ledstream-stop")
 	{
 		disconnect(_hyperion, &Hyperion::rawLedColors, this, 0);
 		_ledStreamTimer->stop();
 		disconnect(_ledStreamConnection);
+		_binaryStream.leds = false;
+	}
+	else if (subcommand == "binarystream-start")
+	{
+		if (!_binaryStreamingSupported)
+		{
+			sendErrorReply("Binary streaming is just available via WebSocket", command + "-" + subcommand, tan);
+			return;
+		}
+
+		_binaryStream.leds = message["leds"].toBool(true);
+		_binaryStream.delta = message["delta"].toBool(true);
+		_binaryStream.image = message["image"].toBool(false);
+		_binaryStream.jpg = message["imageformat"].toString("raw") == "jpg";
+		_binaryStream.imageWidth = message["imagewidth"].toInt(160);
+		// max 50 Hz (20ms) interval for binary streaming (default: 25 Hz (40ms))
+		_binaryStream.interval = qMax(message["interval"].toInt(40), 20);
+		_binaryStream.framesSinceKeyFrame = 0;
+		_binaryStream.lastLeds.clear();
+
+		if (_binaryStream.leds)
+			startLedStream(_binaryStream.interval);
+		if (_binaryStream.image)
+			startImageStream(_binaryStream.jpg ? StreamSubscription::JPG : StreamSubscription::RGB, _binaryStream.imageWidth, _binaryStream.interval);
+
+		QJsonObject info;
+		info["version"] = 1;
+		info["interval"] = _binaryStream.interval;
+		sendSuccessDataReply(QJsonDocument(info), command + "-" + subcommand, tan);
+		return;
+	}
+	else if (subcommand == "binarystream-stop")
+	{
+		if (_binaryStream.leds)
+		{
+			disconnect(_hyperion, &Hyperion::rawLedColors, this, 0);
+			_ledStreamTimer->stop();
+			disconnect(_ledStreamConnection);
+		}
+		if (_binaryStream.image)
+			_imageStream.clear();
+
+		_binaryStream.leds = false;
+		_binaryStream.image = false;
+		_binaryStream.lastLeds.clear();
 	}
 	else if (subcommand == "imagestream-start")
 	{
@@ -1022,11 +1149,14 @@ void JsonAPI::handleLedColorsCommand(const QJsonObject &message, const QString &
 		_streaming_image_reply["command"] = command + "-imagestream-update";
 		_streaming_image_reply["tan"] = tan;
 
-		connect(_hyperion, &Hyperion::currentImage, this, &JsonAPI::setImage, Qt::UniqueConnection);
+		_binaryStream.image = false;
+
+		startImageStream(StreamSubscription::JPG_DATAURL, 0, message["interval"].toInt(0));
 	}
 	else if (subcommand == "imagestream-stop")
 	{
-		disconnect(_hyperion, &Hyperion::currentImage, this, 0);
+		_imageStream.clear();
+		_binaryStream.image = false;
 	}
 	else
 	{
@@ -1036,6 +1166,28 @@ void JsonAPI::handleLedColorsCommand(const QJsonObject &message, const QString &
 	sendSuccessReply(command + "-" + subcommand, tan);
 }
 
+void JsonAPI::startLedStream(int interval)
+{
+	connect(_hyperion, &Hyperion::rawLedColors, this, [=](const std::vector<ColorRgb> &ledValues) {
+		_currentLedValues = ledValues;
+
+		// necessary because Qt::UniqueConnection for lambdas does not work until 5.9
+		// see: https://bugreports.qt.io/browse/QTBUG-52438
+		if (!_ledStreamConnection)
+			_ledStreamConnection = connect(_ledStreamTimer, &QTimer::timeout, this, [=]() {
+				emit streamLedcolorsUpdate(_currentLedValues);
+			},
+										   Qt::UniqueConnection);
+
+		// start the timer
+		if (!_ledStreamTimer->isActive() || _ledStreamTimer->interval() != interval)
+			_ledStreamTimer->start(interval);
+	},
+			Qt::UniqueConnection);
+	// push once
+	_hyperion->update();
+}
+
 void JsonAPI::handleLoggingCommand(const QJsonObject &message, const QString &command, int tan)
 {
 	// create result
@@ -1452,6 +1604,48 @@ void JsonAPI::handleLedDeviceCommand(const QJsonObject &message, const QString &
 	}
 }
 
+void JsonAPI::handleMetricsCommand(const QJsonObject &message, const QString &command, int tan)
+{
+	const QString &subc = message["subcommand"].toString().trimmed();
+	const QString full_command = command + "-" + subc;
+
+	PipelineMetrics &metrics = _hyperion->getMetrics();
+	if (subc == "reset")
+	{
+		metrics.reset();
+		PipelineMetrics::capture().reset();
+		sendSuccessReply(full_command, tan);
+		return;
+	}
+
+	// capture stages are shared by all instances
+	QJsonObject stages = PipelineMetrics::capture().toJson();
+	const QJsonObject instanceStages = metrics.toJson();
+	for (auto it = instanceStages.begin(); it != instanceStages.end(); ++it)
+		stages[it.key()] = it.value();
+
+	const Hyperion::RenderTimings timings = _hyperion->getRenderTimings();
+	QJsonObject render;
+	render["frames"] = static_cast<qint64>(timings.frames);
+	render["skipped"] = static_cast<qint64>(timings.skipped);
+	render["renderLoop"] = _hyperion->isRenderLoopActive();
+	render["writeErrors"] = static_cast<qint64>(metrics.counter(PipelineMetrics::DEVICE_WRITE_ERRORS));
+	render["missedDeadlines"] = static_cast<qint64>(metrics.counter(PipelineMetrics::DEVICE_MISSED_DEADLINES));
+	render["droppedFrames"] = static_cast<qint64>(metrics.counter(PipelineMetrics::DEVICE_DROPPED_FRAMES));
+
+	QJsonObject info;
+	info["instance"] = _hyperion->getInstanceIndex();
+	info["unit"] = "us";
+	info["stages"] = stages;
+	info["render"] = render;
+
+	const MessageForwarder* forwarder = _hyperion->getMessageForwarder();
+	if (forwarder != nullptr)
+		info["forwarder"] = forwarder->getStatistics();
+
+	sendSuccessDataReply(QJsonDocument(info), full_command, tan);
+}
+
 void JsonAPI::handleNotImplemented()
 {
 	sendErrorReply("Command not implemented");
@@ -1466,7 +1660,7 @@ void JsonAPI::sendSuccessReply(const QString &command, int tan)
 	reply["tan"] = tan;
 
 	// send reply
-	emit callbackMessage(reply);
+	sendReply(reply);
 }
 
 void JsonAPI::sendSuccessDataReply(const QJsonDocument &doc, const QString &command, int tan)
@@ -1480,7 +1674,7 @@ void JsonAPI::sendSuccessDataReply(const QJsonDocument &doc, const QString &comm
 	else
 		reply["info"] = doc.object();
 
-	emit callbackMessage(reply);
+	sendReply(reply);
 }
 
 void JsonAPI::sendErrorReply(const QString &error, const QString &command, int tan)
@@ -1493,11 +1687,68 @@ void JsonAPI::sendErrorReply(const QString &error, const QString &command, int t
 	reply["tan"] = tan;
 
 	// send reply
-	emit callbackMessage(reply);
+	sendReply(reply);
+}
+
+void JsonAPI::sendReply(const QJsonObject &reply)
+{
+	if (_batchReplies != nullptr)
+		_batchReplies->append(reply);
+	else
+		emit callbackMessage(reply);
+}
+
+void JsonAPI::queueInput(const PendingInput &input)
+{
+	removePendingInput(input.priority);
+	_pendingInputs.append(input);
+
+	// apply before the reply, a client may close the connection as soon as it is received
+	if (_batchReplies == nullptr)
+		flushPendingInputs();
+}
+
+void JsonAPI::removePendingInput(int priority)
+{
+	for (auto it = _pendingInputs.begin(); it != _pendingInputs.end(); ++it)
+	{
+		if (it->priority == priority)
+		{
+			_pendingInputs.erase(it);
+			return;
+		}
+	}
+}
+
+void JsonAPI::flushPendingInputs()
+{
+	QVector<PendingInput> inputs;
+	inputs.swap(_pendingInputs);
+	for (auto &input : inputs)
+	{
+		emit forwardJsonMessage(input.message);
+
+		if (input.isImage)
+		{
+			QString replyMsg;
+			if (!API::setImage(input.image, COMP_IMAGE, replyMsg))
+				Error(_log, "Failed to set image of priority %d: %s", input.priority, QSTRING_CSTR(replyMsg));
+		}
+		else
+		{
+			API::setColor(input.priority, input.colors, input.duration, input.origin);
+		}
+	}
 }
 
 void JsonAPI::streamLedcolorsUpdate(const std::vector<ColorRgb> &ledColors)
 {
+	if (_binaryStream.leds)
+	{
+		sendBinaryLedColors(ledColors);
+		return;
+	}
+
 	QJsonObject result;
 	QJsonArray leds;
 
@@ -1513,20 +1764,106 @@ void JsonAPI::streamLedcolorsUpdate(const std::vector<ColorRgb> &ledColors)
 	emit callbackMessage(_streaming_leds_reply);
 }
 
-void JsonAPI::setImage(const Image<ColorRgb> &image)
+void JsonAPI::setImage(const QByteArray &frame, int width, int height)
 {
-	QImage jpgImage((const uint8_t *)image.memptr(), image.width(), image.height(), 3 * image.width(), QImage::Format_RGB888);
-	QByteArray ba;
-	QBuffer buffer(&ba);
-	buffer.open(QIODevice::WriteOnly);
-	jpgImage.save(&buffer, "jpg");
+	if (_binaryStream.image)
+	{
+		QByteArray binaryFrame = binaryFrameHeader(_binaryStream.jpg ? BINARY_IMAGE_JPG : BINARY_IMAGE_RGB,
+												   static_cast<quint16>(width), static_cast<quint16>(height));
+		binaryFrame.append(frame);
+		emit callbackBinaryMessage(binaryFrame);
+		return;
+	}
 
 	QJsonObject result;
-	result["image"] = "data:image/jpg;base64," + QString(ba.toBase64());
+	result["image"] = QString::fromLatin1(frame);
 	_streaming_image_reply["result"] = result;
 	emit callbackMessage(_streaming_image_reply);
 }
 
+void JsonAPI::startImageStream(StreamSubscription::Format format, int width, int interval)
+{
+	StreamPublisher *publisher = _hyperion->getStreamPublisher();
+	if (publisher == nullptr)
+		return;
+
+	// the encoded frames are shared with all other clients of the same format and width
+	_imageStream = publisher->subscribe(format, width, interval);
+	connect(_imageStream.data(), &StreamSubscription::frameReady, this, &JsonAPI::setImage);
+}
+
+QByteArray JsonAPI::binaryFrameHeader(quint8 type, quint16 width, quint16 height)
+{
+	QByteArray header;
+	header.append(static_cast<char>(BINARY_STREAM_VERSION));
+	header.append(static_cast<char>(type));
+	appendUInt16(header, _binaryStream.sequence++);
+	appendUInt16(header, width);
+	appendUInt16(header, height);
+	return header;
+}
+
+void JsonAPI::sendBinaryLedColors(const std::vector<ColorRgb> &ledColors)
+{
+	const int count = qMin(static_cast<int>(ledColors.size()), 0xFFFF);
+	const std::vector<ColorRgb> &last = _binaryStream.lastLeds;
+
+	bool keyFrame = !_binaryStream.delta
+			|| last.size() != ledColors.size()
+			|| _binaryStream.framesSinceKeyFrame >= BINARY_KEYFRAME_INTERVAL;
+
+	QByteArray runs;
+	if (!keyFrame)
+	{
+		// runs of changed leds: start, length, colors
+		int i = 0;
+		while (i < count)
+		{
+			if (ledColors[i] == last[i])
+			{
+				++i;
+				continue;
+			}
+
+			// a single unchanged led is cheaper than the header of a new run
+			int end = i + 1;
+			while (end < count && (ledColors[end] != last[end] || (end + 1 < count && ledColors[end + 1] != last[end + 1])))
+				++end;
+
+			appendUInt16(runs, static_cast<quint16>(i));
+			appendUInt16(runs, static_cast<quint16>(end - i));
+			runs.append(reinterpret_cast<const char *>(&ledColors[i]), (end - i) * 3);
+			i = end;
+		}
+
+		// nothing changed, nothing to send
+		if (runs.isEmpty())
+		{
+			++_binaryStream.framesSinceKeyFrame;
+			return;
+		}
+
+		keyFrame = runs.size() >= count * 3;
+	}
+
+	QByteArray frame;
+	if (keyFrame)
+	{
+		frame = binaryFrameHeader(BINARY_LEDS_RAW, static_cast<quint16>(count), 0);
+		frame.append(reinterpret_cast<const char *>(ledColors.data()), count * 3);
+		_binaryStream.framesSinceKeyFrame = 0;
+	}
+	else
+	{
+		frame = binaryFrameHeader(BINARY_LEDS_DELTA, static_cast<quint16>(count), 0);
+		frame.append(runs);
+		++_binaryStream.framesSinceKeyFrame;
+	}
+
+	_binaryStream.lastLeds = ledColors;
+	emit callbackBinaryMessage(frame);
+}
+
 void JsonAPI::incommingLogMessage(const Logger::T_LOG_MESSAGE &msg)
 {
 	QJsonObject result, message;
@@ -1612,6 +1949,8 @@ void JsonAPI::handleInstanceStateChange(InstanceState state, quint8 instance, co
 
 void JsonAPI::stopDataConnections()
 {
+	// inputs of an interrupted batch are not lost
+	flushPendingInputs();
 	LoggerManager::getInstance()->disconnect();
 	_streaming_logging_activated = false;
 	_jsonCB->resetSubscriptions();
@@ -1619,4 +1958,8 @@ void JsonAPI::stopDataConnections()
 	disconnect(_hyperion, &Hyperion::rawLedColors, this, 0);
 	_ledStreamTimer->stop();
 	disconnect(_ledStreamConnection);
+	// image stream
+	_imageStream.clear();
+	_binaryStream.leds = false;
+	_binaryStream.image = false;
 }
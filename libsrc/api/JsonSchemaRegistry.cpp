@@ -0,0 +1,45 @@
+// project includes
+#include <api/JsonSchemaRegistry.h>
+
+// util includes
+#include <utils/JsonUtils.h>
+#include <utils/Logger.h>
+
+// qt includes
+#include <QDir>
+
+const JsonSchemaRegistry& JsonSchemaRegistry::getInstance()
+{
+	// thread-safe initialization of function local statics
+	static const JsonSchemaRegistry registry;
+	return registry;
+}
+
+JsonSchemaRegistry::JsonSchemaRegistry()
+{
+	Q_INIT_RESOURCE(JSONRPC_schemas);
+
+	Logger* log = Logger::getInstance("JSONRPC");
+	const QStringList entries = QDir(":/").entryList(QStringList() << "schema" << "schema-*", QDir::Files);
+	for (const QString& entry : entries)
+	{
+		QJsonObject schema;
+		if (JsonUtils::readFile(":/" + entry, schema, log))
+		{
+			_schemas.insert(entry, schema);
+		}
+	}
+	Debug(log, "Loaded %d JSON-RPC schemas", _schemas.size());
+}
+
+bool JsonSchemaRegistry::validate(const QString& ident, const QJsonObject& message, const QString& schema, Logger* log) const
+{
+	auto it = _schemas.constFind(schema);
+	if (it == _schemas.constEnd())
+	{
+		Error(log, "While validating json data of '%s': Unknown schema '%s'", QSTRING_CSTR(ident), QSTRING_CSTR(schema));
+		return false;
+	}
+
+	return JsonUtils::validate(ident, message, it.value(), log);
+}
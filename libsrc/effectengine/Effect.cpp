@@ -5,7 +5,6 @@
 
 // Qt includes
 #include <QDateTime>
-#include <QFile>
 #include <Qt>
 #include <QLinearGradient>
 #include <QConicalGradient>
@@ -98,21 +97,6 @@ void Effect::run()
 		_endTime = QDateTime::currentMSecsSinceEpoch() + _timeout;
 	}
 
-	// Run the effect script
-	QFile file (_script);
-	QByteArray python_code;
-	if (file.open(QIODevice::ReadOnly))
-	{
-		python_code = file.readAll();
-	}
-	else
-	{
-		Error(_log, "Unable to open script file %s.", QSTRING_CSTR(_script));
-	}
-	file.close();
-
-	if (!python_code.isEmpty())
-	{
-		program.execute(python_code);
-	}
+	// Run the effect script, the compiled code is cached between runs
+	program.executeScript(_script);
 }
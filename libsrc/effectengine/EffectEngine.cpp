@@ -182,6 +182,7 @@ int EffectEngine::runEffectScript(const QString &script, const QString &name, co
 	connect(effect, &QThread::finished, this, &EffectEngine::effectFinished);
 	connect(_hyperion, &Hyperion::finished, effect, &Effect::requestInterruption, Qt::DirectConnection);
 	_activeEffects.push_back(effect);
+	_hyperion->getMetrics().set(PipelineMetrics::ACTIVE_EFFECTS, _activeEffects.size());
 
 	// start the effect
 	Debug(_log, "Start the effect: name [%s], smoothCfg [%u]", QSTRING_CSTR(name), smoothCfg);
@@ -231,6 +232,7 @@ void EffectEngine::effectFinished()
 			break;
 		}
 	}
+	_hyperion->getMetrics().set(PipelineMetrics::ACTIVE_EFFECTS, _activeEffects.size());
 
 	// cleanup the effect
 	effect->deleteLater();
@@ -6,6 +6,7 @@
 // hyperion
 #include <hyperion/Hyperion.h>
 #include <utils/Logger.h>
+#include <utils/Simd.h>
 
 // qt
 #include <QJsonArray>
@@ -16,6 +17,60 @@
 // Get the effect from the capsule
 #define getEffect() static_cast<Effect*>((Effect*)PyCapsule_Import("hyperion.__effectObj", 0))
 
+namespace {
+
+#if defined(SIMD_SSSE3) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+///
+/// SSSE3 part of convertScanline()
+/// @return Number of pixels converted
+///
+SIMD_TARGET_SSSE3 int convertScanlineSsse3(const QRgb* src, ColorRgb* dst, int width)
+{
+	// 4 pixels per step, the 16 byte store writes 4 bytes ahead which are overwritten by the next step
+	const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	int x = 0;
+	for (; x + 6 <= width; x += 4)
+	{
+		const __m128i bgra = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + x));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_shuffle_epi8(bgra, shuffle));
+	}
+	return x;
+}
+#endif
+
+///
+/// Convert a 32 bit scanline (QRgb, in memory B,G,R,A on little endian) to packed RGB, alpha is dropped
+///
+void convertScanline(const QRgb* src, ColorRgb* dst, int width)
+{
+	int x = 0;
+#if defined(SIMD_SSSE3) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+	if (simd::hasSsse3())
+	{
+		x = convertScanlineSsse3(src, dst, width);
+	}
+#elif defined(SIMD_NEON) && Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+	// 16 pixels per step
+	for (; x + 16 <= width; x += 16)
+	{
+		const uint8x16x4_t bgra = vld4q_u8(reinterpret_cast<const uint8_t*>(src + x));
+		uint8x16x3_t rgb;
+		rgb.val[0] = bgra.val[2];
+		rgb.val[1] = bgra.val[1];
+		rgb.val[2] = bgra.val[0];
+		vst3q_u8(reinterpret_cast<uint8_t*>(dst + x), rgb);
+	}
+#endif
+	for (; x < width; ++x)
+	{
+		dst[x].red   = static_cast<uint8_t>(qRed(src[x]));
+		dst[x].green = static_cast<uint8_t>(qGreen(src[x]));
+		dst[x].blue  = static_cast<uint8_t>(qBlue(src[x]));
+	}
+}
+
+}
+
 // create the hyperion module
 struct PyModuleDef EffectModule::moduleDef = {
 	PyModuleDef_HEAD_INIT,
@@ -356,26 +411,30 @@ PyObject* EffectModule::wrapImageShow(PyObject *self, PyObject *args)
 	}
 
 
-	QImage * qimage = (imgId<0) ? &(getEffect()->_image) : &(getEffect()->_imageStack[imgId]);
-	int width = qimage->width();
-	int height = qimage->height();
+	Effect * effect = getEffect();
+	const QImage * qimage = (imgId<0) ? &(effect->_image) : &(effect->_imageStack[imgId]);
 
-	Image<ColorRgb> image(width, height);
-	QByteArray binaryImage;
+	// the scanlines are read as QRgb
+	QImage converted;
+	if (qimage->depth() != 32)
+	{
+		converted = qimage->convertToFormat(QImage::Format_RGB32);
+		qimage = &converted;
+	}
+
+	const int width = qimage->width();
+	const int height = qimage->height();
+
+	// the previous images may still be referenced by Hyperion
+	Image<ColorRgb> & image = effect->_outputImages.acquire(width, height);
 
+	ColorRgb * dst = image.memptr();
 	for (int i = 0; i<height; ++i)
 	{
-		const QRgb * scanline = reinterpret_cast<const QRgb *>(qimage->scanLine(i));
-		for (int j = 0; j< width; ++j)
-		{
-			binaryImage.append((char) qRed(scanline[j]));
-			binaryImage.append((char) qGreen(scanline[j]));
-			binaryImage.append((char) qBlue(scanline[j]));
-		}
+		convertScanline(reinterpret_cast<const QRgb *>(qimage->constScanLine(i)), dst + i * width, width);
 	}
 
-	memcpy(image.memptr(), binaryImage.data(), binaryImage.size());
-	emit getEffect()->setInputImage(getEffect()->_priority, image, timeout, false);
+	emit effect->setInputImage(effect->_priority, image, timeout, false);
 
 	return Py_BuildValue("");
 }
@@ -1,19 +1,140 @@
 #include "FlatBufferClient.h"
 
+// util
+#include <utils/ServerMetrics.h>
+#include <utils/ColorSys.h>
+
 // qt
 #include <QTcpSocket>
+#include <QUdpSocket>
 #include <QHostAddress>
 #include <QTimer>
 #include <QRgb>
 
+namespace {
+
+/// Upper limit of a single message, fits an uncompressed 4k image
+const uint32_t MAX_MESSAGE_SIZE = 48 * 1024 * 1024;
+
+///
+/// @brief Decompress a LZ4 block, the output size has to be known
+/// @return True if the block decompresses to exactly dstSize bytes
+///
+bool decompressLz4Block(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	const uint8_t* ip = src;
+	const uint8_t* const iend = src + srcSize;
+	uint8_t* op = dst;
+	uint8_t* const oend = dst + dstSize;
+
+	auto readLength = [&](size_t& length) -> bool
+	{
+		uint8_t s;
+		do
+		{
+			if (ip >= iend)
+				return false;
+			s = *ip++;
+			length += s;
+		} while (s == 255);
+		return true;
+	};
+
+	while (ip < iend)
+	{
+		const uint8_t token = *ip++;
+
+		// literals
+		size_t length = token >> 4;
+		if (length == 15 && !readLength(length))
+			return false;
+		if (length > size_t(iend - ip) || length > size_t(oend - op))
+			return false;
+		memcpy(op, ip, length);
+		ip += length;
+		op += length;
+
+		// the last sequence consists of literals only
+		if (ip == iend)
+			break;
+
+		// match
+		if (iend - ip < 2)
+			return false;
+		const size_t offset = ip[0] | (ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > size_t(op - dst))
+			return false;
+
+		length = token & 0x0F;
+		if (length == 15 && !readLength(length))
+			return false;
+		length += 4;
+		if (length > size_t(oend - op))
+			return false;
+
+		// the match may overlap with the output
+		const uint8_t* match = op - offset;
+		if (offset >= length)
+		{
+			memcpy(op, match, length);
+			op += length;
+		}
+		else
+		{
+			while (length-- > 0)
+				*op++ = *match++;
+		}
+	}
+	return op == oend;
+}
+
+void decodeRgb565(const uint8_t* src, ColorRgb* dst, size_t pixels)
+{
+	for (size_t i = 0; i < pixels; ++i, src += 2)
+	{
+		const uint16_t value = uint16_t(src[0] | (src[1] << 8));
+		const uint8_t r = (value >> 11) & 0x1F;
+		const uint8_t g = (value >> 5) & 0x3F;
+		const uint8_t b = value & 0x1F;
+		dst[i] = ColorRgb{ uint8_t((r << 3) | (r >> 2)), uint8_t((g << 2) | (g >> 4)), uint8_t((b << 3) | (b >> 2)) };
+	}
+}
+
+///
+/// @brief Convert a 4:2:0 image, the chroma samples are addressed by uvStep (1: planar, 2: interleaved)
+///
+void decodeYuv420(const uint8_t* yPlane, const uint8_t* uPlane, const uint8_t* vPlane, int uvStep, int width, int height, ColorRgb* dst)
+{
+	const int uvWidth = (width + 1) / 2;
+	for (int y = 0; y < height; ++y)
+	{
+		const uint8_t* yLine = yPlane + y * width;
+		const uint8_t* uLine = uPlane + (y / 2) * uvWidth * uvStep;
+		const uint8_t* vLine = vPlane + (y / 2) * uvWidth * uvStep;
+		for (int x = 0; x < width; ++x, ++dst)
+		{
+			const int uv = (x / 2) * uvStep;
+			ColorSys::yuv2rgb(yLine[x], uLine[uv], vLine[uv], dst->red, dst->green, dst->blue);
+		}
+	}
+}
+
+}
+
 FlatBufferClient::FlatBufferClient(QTcpSocket* socket, int timeout, QObject *parent)
 	: QObject(parent)
 	, _log(Logger::getInstance("FLATBUFSERVER"))
 	, _socket(socket)
+	, _udpSocket(nullptr)
+	, _peerPort(0)
 	, _clientAddress("@"+socket->peerAddress().toString())
 	, _timeoutTimer(new QTimer(this))
 	, _timeout(timeout * 1000)
 	, _priority()
+	, _noReply(false)
+	, _readOffset(0)
+	, _writeOffset(0)
 {
 	// timer setup
 	_timeoutTimer->setSingleShot(true);
@@ -25,50 +146,143 @@ FlatBufferClient::FlatBufferClient(QTcpSocket* socket, int timeout, QObject *par
 	connect(_socket, &QTcpSocket::disconnected, this, &FlatBufferClient::disconnected);
 }
 
+FlatBufferClient::FlatBufferClient(QUdpSocket* socket, const QHostAddress& peerAddress, quint16 peerPort, int timeout, QObject *parent)
+	: QObject(parent)
+	, _log(Logger::getInstance("FLATBUFSERVER"))
+	, _socket(nullptr)
+	, _udpSocket(socket)
+	, _peerAddress(peerAddress)
+	, _peerPort(peerPort)
+	, _clientAddress("@"+peerAddress.toString())
+	, _timeoutTimer(new QTimer(this))
+	, _timeout(timeout * 1000)
+	, _priority()
+	, _noReply(true)
+	, _readOffset(0)
+	, _writeOffset(0)
+{
+	// without a connection the timeout ends the client
+	_timeoutTimer->setSingleShot(true);
+	_timeoutTimer->setInterval(_timeout);
+	connect(_timeoutTimer, &QTimer::timeout, this, &FlatBufferClient::forceClose);
+	_timeoutTimer->start();
+}
+
+void FlatBufferClient::handleDatagramMessage(const uint8_t* data, uint32_t size)
+{
+	_timeoutTimer->start();
+	handleRawMessage(data, size);
+}
+
 void FlatBufferClient::readyRead()
 {
 	_timeoutTimer->start();
 
-	_receiveBuffer += _socket->readAll();
+	const qint64 available = _socket->bytesAvailable();
+	if (available <= 0)
+		return;
 
-	// check if we can read a header
-	while(_receiveBuffer.size() >= 4)
+	// make room for the new data, keep the unhandled part only
+	if (_writeOffset + available > _receiveBuffer.size())
 	{
-		uint32_t messageSize =
-			((_receiveBuffer[0]<<24) & 0xFF000000) |
-			((_receiveBuffer[1]<<16) & 0x00FF0000) |
-			((_receiveBuffer[2]<< 8) & 0x0000FF00) |
-			((_receiveBuffer[3]    ) & 0x000000FF);
+		if (_readOffset > 0)
+		{
+			memmove(_receiveBuffer.data(), _receiveBuffer.constData() + _readOffset, _writeOffset - _readOffset);
+			_writeOffset -= _readOffset;
+			_readOffset = 0;
+		}
+		if (_writeOffset + available > _receiveBuffer.size())
+		{
+			_receiveBuffer.resize(_writeOffset + available);
+		}
+	}
 
-		// check if we can read a complete message
-		if((uint32_t) _receiveBuffer.size() < messageSize + 4) return;
+	// read straight into the receive buffer
+	const qint64 bytes = _socket->read(_receiveBuffer.data() + _writeOffset, available);
+	if (bytes <= 0)
+		return;
 
-		// extract message only and remove header + msg from buffer :: QByteArray::remove() does not return the removed data
-		const QByteArray msg = _receiveBuffer.mid(4, messageSize);
-		_receiveBuffer.remove(0, messageSize + 4);
+	ServerMetrics::addReceivedBytes(ServerMetrics::FLATBUFSERVER, bytes);
+	_writeOffset += bytes;
+
+	processMessages();
+}
+
+void FlatBufferClient::processMessages()
+{
+	// check if we can read a header
+	while (_writeOffset - _readOffset >= 4)
+	{
+		const auto* header = reinterpret_cast<const uint8_t*>(_receiveBuffer.constData()) + _readOffset;
+		const uint32_t messageSize = (uint32_t(header[0]) << 24) | (uint32_t(header[1]) << 16) | (uint32_t(header[2]) << 8) | uint32_t(header[3]);
+
+		if (messageSize > MAX_MESSAGE_SIZE)
+		{
+			Error(_log, "Message from client %s exceeds the maximum size of %u bytes", QSTRING_CSTR(_clientAddress), MAX_MESSAGE_SIZE);
+			sendErrorReply("Message too large");
+			_readOffset = _writeOffset = 0;
+			forceClose();
+			return;
+		}
 
-		const auto* msgData = reinterpret_cast<const uint8_t*>(msg.constData());
-		flatbuffers::Verifier verifier(msgData, messageSize);
+		// check if we can read a complete message
+		if (uint32_t(_writeOffset - _readOffset - 4) < messageSize)
+		{
+			// let the next read fill the buffer up to the end of the message
+			if (_readOffset + 4 + int(messageSize) > _receiveBuffer.size())
+			{
+				_receiveBuffer.resize(_readOffset + 4 + messageSize);
+			}
+			break;
+		}
 
-		if (hyperionnet::VerifyRequestBuffer(verifier))
+		// flatbuffers expects its scalars 4 byte aligned, realign the rare messages which are not
+		if (_readOffset % 4 != 0)
 		{
-			auto message = hyperionnet::GetRequest(msgData);
-			handleMessage(message);
+			memmove(_receiveBuffer.data(), _receiveBuffer.constData() + _readOffset, _writeOffset - _readOffset);
+			_writeOffset -= _readOffset;
+			_readOffset = 0;
 			continue;
 		}
-		sendErrorReply("Unable to parse message");
+
+		// verify and read the message in place
+		const auto* msgData = reinterpret_cast<const uint8_t*>(_receiveBuffer.constData()) + _readOffset + 4;
+		_readOffset += 4 + messageSize;
+
+		handleRawMessage(msgData, messageSize);
+	}
+
+	// all messages handled, start over at the front
+	if (_readOffset == _writeOffset)
+	{
+		_readOffset = _writeOffset = 0;
+	}
+}
+
+void FlatBufferClient::handleRawMessage(const uint8_t* data, uint32_t size)
+{
+	flatbuffers::Verifier verifier(data, size);
+	if (hyperionnet::VerifyRequestBuffer(verifier))
+	{
+		handleMessage(hyperionnet::GetRequest(data));
+		return;
 	}
+	sendErrorReply("Unable to parse message");
 }
 
 void FlatBufferClient::forceClose()
 {
-	_socket->close();
+	if (_socket != nullptr)
+		_socket->close();
+	else
+		disconnected();
 }
 
 void FlatBufferClient::disconnected()
 {
 	Debug(_log, "Socket Closed");
-	_socket->deleteLater();
+	if (_socket != nullptr)
+		_socket->deleteLater();
 	if (_priority != 0 && _priority >= 100 && _priority < 200)
 		emit clearGlobalInput(_priority);
 
@@ -128,6 +342,8 @@ void FlatBufferClient::handleRegisterCommand(const hyperionnet::Register *regReq
 	}
 
 	_priority = regReq->priority();
+	// UDP senders can not wait for replies anyway
+	_noReply = regReq->no_reply() || _udpSocket != nullptr;
 	emit registerGlobalInput(_priority, hyperion::COMP_FLATBUFSERVER, regReq->origin()->c_str()+_clientAddress);
 
 	auto reply = hyperionnet::CreateReplyDirect(_builder, nullptr, -1, (_priority ? _priority : -1));
@@ -152,14 +368,77 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 		const int width = img->width();
 		const int height = img->height();
 
-		if ((int) imageData->size() != width*height*3)
+		if (imageData == nullptr || width <= 0 || height <= 0 || (int64_t) imageData->size() != int64_t(width)*height*3)
+		{
+			sendErrorReply("Size of image data does not match with the width and height");
+			return;
+		}
+
+		Image<ColorRgb>& imageDest = _imagePool.acquire(width, height);
+		memcpy(imageDest.memptr(), imageData->data(), imageData->size());
+		emit setGlobalInputImage(_priority, imageDest, duration);
+	}
+	else if ((reqPtr = image->data_as_YuvImage()) != nullptr)
+	{
+		const auto *img = static_cast<const hyperionnet::YuvImage*>(reqPtr);
+		const auto & imageData = img->data();
+		const int width = img->width();
+		const int height = img->height();
+		const int64_t uvSize = int64_t((width + 1) / 2) * ((height + 1) / 2);
+
+		if (imageData == nullptr || width <= 0 || height <= 0 || (int64_t) imageData->size() != int64_t(width)*height + 2*uvSize)
 		{
 			sendErrorReply("Size of image data does not match with the width and height");
 			return;
 		}
 
-		Image<ColorRgb> imageDest(width, height);
-		memmove(imageDest.memptr(), imageData->data(), imageData->size());
+		const uint8_t* yPlane = imageData->data();
+		const uint8_t* uvPlane = yPlane + width*height;
+
+		Image<ColorRgb>& imageDest = _imagePool.acquire(width, height);
+		if (img->format() == hyperionnet::YuvFormat_I420)
+			decodeYuv420(yPlane, uvPlane, uvPlane + uvSize, 1, width, height, imageDest.memptr());
+		else
+			decodeYuv420(yPlane, uvPlane, uvPlane + 1, 2, width, height, imageDest.memptr());
+		emit setGlobalInputImage(_priority, imageDest, duration);
+	}
+	else if ((reqPtr = image->data_as_Rgb565Image()) != nullptr)
+	{
+		const auto *img = static_cast<const hyperionnet::Rgb565Image*>(reqPtr);
+		const auto & imageData = img->data();
+		const int width = img->width();
+		const int height = img->height();
+
+		if (imageData == nullptr || width <= 0 || height <= 0 || (int64_t) imageData->size() != int64_t(width)*height*2)
+		{
+			sendErrorReply("Size of image data does not match with the width and height");
+			return;
+		}
+
+		Image<ColorRgb>& imageDest = _imagePool.acquire(width, height);
+		decodeRgb565(imageData->data(), imageDest.memptr(), size_t(width)*height);
+		emit setGlobalInputImage(_priority, imageDest, duration);
+	}
+	else if ((reqPtr = image->data_as_Lz4RgbImage()) != nullptr)
+	{
+		const auto *img = static_cast<const hyperionnet::Lz4RgbImage*>(reqPtr);
+		const auto & imageData = img->data();
+		const int width = img->width();
+		const int height = img->height();
+
+		// limit the decompressed size to the size of an uncompressed message, before the buffer is allocated
+		if (imageData == nullptr || width <= 0 || height <= 0 || int64_t(width)*height*3 > int64_t(MAX_MESSAGE_SIZE))
+		{
+			sendErrorReply("Invalid width and height of compressed image");
+			return;
+		}
+
+		Image<ColorRgb>& imageDest = _imagePool.acquire(width, height);
+		if (!decompressLz4Block(imageData->data(), imageData->size(), reinterpret_cast<uint8_t*>(imageDest.memptr()), size_t(width)*height*3))
+		{
+			sendErrorReply("Size of decompressed image data does not match with the width and height");
+			return;
+		}
 		emit setGlobalInputImage(_priority, imageDest, duration);
 	}
 
@@ -167,7 +446,6 @@ void FlatBufferClient::handleImageCommand(const hyperionnet::Image *image)
 	sendSuccessReply();
 }
 
-
 void FlatBufferClient::handleClearCommand(const hyperionnet::Clear *clear)
 {
 	// extract parameters
@@ -192,14 +470,28 @@ void FlatBufferClient::sendMessage()
 {
 	auto size = _builder.GetSize();
 	const uint8_t* buffer = _builder.GetBufferPointer();
-	uint8_t sizeData[] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
-	_socket->write((const char *) sizeData, sizeof(sizeData));
-	_socket->write((const char *)buffer, size);
-	_socket->flush();
+
+	// datagrams carry the reply only, their size is known
+	if (_udpSocket != nullptr)
+	{
+		_udpSocket->writeDatagram(reinterpret_cast<const char *>(buffer), size, _peerAddress, _peerPort);
+		return;
+	}
+
+	QByteArray message;
+	message.reserve(4 + size);
+	message.append(char(size >> 24)).append(char(size >> 16)).append(char(size >> 8)).append(char(size));
+	message.append(reinterpret_cast<const char *>(buffer), size);
+
+	// no flush, the socket sends all replies of this event loop iteration at once
+	_socket->write(message);
 }
 
 void FlatBufferClient::sendSuccessReply()
 {
+	if (_noReply)
+		return;
+
 	auto reply = hyperionnet::CreateReplyDirect(_builder);
 	_builder.Finish(reply);
 
@@ -5,12 +5,17 @@
 #include <utils/Image.h>
 #include <utils/ColorRgb.h>
 #include <utils/Components.h>
+#include <utils/ImagePool.h>
 
 // flatbuffer FBS
 #include "hyperion_reply_generated.h"
 #include "hyperion_request_generated.h"
 
+// qt
+#include <QHostAddress>
+
 class QTcpSocket;
+class QUdpSocket;
 class QTimer;
 
 namespace flatbuf {
@@ -32,6 +37,24 @@ public:
 	///
 	explicit FlatBufferClient(QTcpSocket* socket, int timeout, QObject *parent = nullptr);
 
+	///
+	/// @brief Construct a client of a UDP sender, which gets its messages from handleDatagramMessage()
+	/// Replies are sent on errors and registration only, as datagrams without size header
+	/// @param socket       The socket of the server to reply with
+	/// @param peerAddress  The address of the sender
+	/// @param peerPort     The port of the sender
+	/// @param timeout      The timeout when the client is removed and the priority unregistered
+	/// @param parent       The parent
+	///
+	FlatBufferClient(QUdpSocket* socket, const QHostAddress& peerAddress, quint16 peerPort, int timeout, QObject *parent = nullptr);
+
+	///
+	/// @brief Handle a complete message of a UDP sender
+	/// @param data  The flatbuffer request
+	/// @param size  The size of the request
+	///
+	void handleDatagramMessage(const uint8_t* data, uint32_t size);
+
 signals:
 	///
 	/// @brief forward register data to HyperionDaemon
@@ -103,6 +126,16 @@ private:
 	///
 	void handleImageCommand(const hyperionnet::Image *image);
 
+	///
+	/// @brief Handle all complete messages of the receive buffer
+	///
+	void processMessages();
+
+	///
+	/// @brief Verify and handle a single message
+	///
+	void handleRawMessage(const uint8_t* data, uint32_t size);
+
 	///
 	/// @brief Handle clear command
 	///
@@ -135,12 +168,25 @@ private:
 private:
 	Logger *_log;
 	QTcpSocket *_socket;
+	QUdpSocket *_udpSocket;
+	const QHostAddress _peerAddress;
+	const quint16 _peerPort;
 	const QString _clientAddress;
 	QTimer *_timeoutTimer;
 	int _timeout;
 	int _priority;
+	/// true if the client requested to get replies on errors only
+	bool _noReply;
 
+	/// received data, messages are verified and read in place
 	QByteArray _receiveBuffer;
+	/// start of the first unhandled message in _receiveBuffer
+	int _readOffset;
+	/// end of the received data in _receiveBuffer
+	int _writeOffset;
+
+	/// decoded images, recycled once Hyperion released them
+	ImagePool<ColorRgb> _imagePool;
 
 	// Flatbuffers builder
 	flatbuffers::FlatBufferBuilder _builder;
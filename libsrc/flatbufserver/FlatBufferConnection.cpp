@@ -95,7 +95,8 @@ void FlatBufferConnection::setSkipReply(bool skip)
 
 void FlatBufferConnection::setRegister(const QString& origin, int priority)
 {
-	auto registerReq = hyperionnet::CreateRegister(_builder, _builder.CreateString(QSTRING_CSTR(origin)), priority);
+	// just errors and registration requests are of interest, skip the success replies
+	auto registerReq = hyperionnet::CreateRegister(_builder, _builder.CreateString(QSTRING_CSTR(origin)), priority, true);
 	auto req = hyperionnet::CreateRequest(_builder, hyperionnet::Command_Register, registerReq.Union());
 
 	_builder.Finish(req);
@@ -1,9 +1,11 @@
 #include <flatbufserver/FlatBufferServer.h>
 #include "FlatBufferClient.h"
+#include "FlatBufferUdpReceiver.h"
 
 // util
 #include <utils/NetOrigin.h>
 #include <utils/GlobalSignals.h>
+#include <utils/ServerMetrics.h>
 
 // qt
 #include <QJsonObject>
@@ -13,8 +15,10 @@
 FlatBufferServer::FlatBufferServer(const QJsonDocument& config, QObject* parent)
 	: QObject(parent)
 	, _server(new QTcpServer(this))
+	, _udpReceiver(nullptr)
 	, _log(Logger::getInstance("FLATBUFSERVER"))
 	, _timeout(5000)
+	, _udpEnabled(false)
 	, _config(config)
 {
 
@@ -31,6 +35,9 @@ void FlatBufferServer::initServer()
 	_netOrigin = NetOrigin::getInstance();
 	connect(_server, &QTcpServer::newConnection, this, &FlatBufferServer::newConnection);
 
+	_udpReceiver = new FlatBufferUdpReceiver(this);
+	connect(_udpReceiver, &FlatBufferUdpReceiver::newClient, this, &FlatBufferServer::addClient);
+
 	// apply config
 	handleSettingsUpdate(settings::FLATBUFSERVER, _config);
 }
@@ -52,6 +59,7 @@ void FlatBufferServer::handleSettingsUpdate(settings::type type, const QJsonDocu
 
 		// new timeout just for new connections
 		_timeout = obj["timeout"].toInt(5000);
+		_udpEnabled = obj["udp"].toBool(false);
 		// enable check
 		obj["enable"].toBool(true) ? startServer() : stopServer();
 	}
@@ -66,15 +74,7 @@ void FlatBufferServer::newConnection()
 			if(_netOrigin->accessAllowed(socket->peerAddress(), socket->localAddress()))
 			{
 				Debug(_log, "New connection from %s", QSTRING_CSTR(socket->peerAddress().toString()));
-				FlatBufferClient *client = new FlatBufferClient(socket, _timeout, this);
-				// internal
-				connect(client, &FlatBufferClient::clientDisconnected, this, &FlatBufferServer::clientDisconnected);
-				connect(client, &FlatBufferClient::registerGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::registerGlobalInput);
-				connect(client, &FlatBufferClient::clearGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::clearGlobalInput);
-				connect(client, &FlatBufferClient::setGlobalInputImage, GlobalSignals::getInstance(), &GlobalSignals::setGlobalImage);
-				connect(client, &FlatBufferClient::setGlobalInputColor, GlobalSignals::getInstance(), &GlobalSignals::setGlobalColor);
-				connect(GlobalSignals::getInstance(), &GlobalSignals::globalRegRequired, client, &FlatBufferClient::registationRequired);
-				_openConnections.append(client);
+				addClient(new FlatBufferClient(socket, _timeout, this));
 			}
 			else
 				socket->close();
@@ -82,11 +82,25 @@ void FlatBufferServer::newConnection()
 	}
 }
 
+void FlatBufferServer::addClient(FlatBufferClient* client)
+{
+	// internal
+	connect(client, &FlatBufferClient::clientDisconnected, this, &FlatBufferServer::clientDisconnected);
+	connect(client, &FlatBufferClient::registerGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::registerGlobalInput);
+	connect(client, &FlatBufferClient::clearGlobalInput, GlobalSignals::getInstance(), &GlobalSignals::clearGlobalInput);
+	connect(client, &FlatBufferClient::setGlobalInputImage, GlobalSignals::getInstance(), &GlobalSignals::setGlobalImage);
+	connect(client, &FlatBufferClient::setGlobalInputColor, GlobalSignals::getInstance(), &GlobalSignals::setGlobalColor);
+	connect(GlobalSignals::getInstance(), &GlobalSignals::globalRegRequired, client, &FlatBufferClient::registationRequired);
+	_openConnections.append(client);
+	ServerMetrics::setClients(ServerMetrics::FLATBUFSERVER, _openConnections.size());
+}
+
 void FlatBufferServer::clientDisconnected()
 {
 	FlatBufferClient* client = qobject_cast<FlatBufferClient*>(sender());
 	client->deleteLater();
 	_openConnections.removeAll(client);
+	ServerMetrics::setClients(ServerMetrics::FLATBUFSERVER, _openConnections.size());
 }
 
 void FlatBufferServer::startServer()
@@ -102,14 +116,23 @@ void FlatBufferServer::startServer()
 	        Info(_log,"Started on port %d", _port);
 	    }
 	}
+
+	if(_udpEnabled)
+		_udpReceiver->start(_port, _timeout);
+	else
+		_udpReceiver->stop();
 }
 
 void FlatBufferServer::stopServer()
 {
+	if(_udpReceiver != nullptr)
+		_udpReceiver->stop();
+
 	if(_server->isListening())
 	{
-		// close client connections
-		for(const auto& client : _openConnections)
+		// close client connections, closing removes them from the list
+		const QVector<FlatBufferClient*> clients = _openConnections;
+		for(const auto& client : clients)
 		{
 			client->forceClose();
 		}
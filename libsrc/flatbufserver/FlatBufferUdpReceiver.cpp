@@ -0,0 +1,232 @@
+#include "FlatBufferUdpReceiver.h"
+#include "FlatBufferClient.h"
+
+// util
+#include <utils/NetOrigin.h>
+#include <utils/ServerMetrics.h>
+
+// qt
+#include <QUdpSocket>
+#include <QNetworkInterface>
+
+namespace {
+
+const int HEADER_SIZE = 12;
+const quint8 PROTOCOL_VERSION = 1;
+
+/// Upper limit of a single request, fits an uncompressed 1080p image
+const quint32 MAX_REQUEST_SIZE = 16 * 1024 * 1024;
+
+/// Maximum number of concurrent senders
+const int MAX_PEERS = 32;
+
+/// A sequence number this far behind the last one is a restarted sender, not a late frame
+const qint16 RESYNC_DISTANCE = 256;
+
+inline quint16 readUInt16(const uint8_t* data)
+{
+	return quint16((data[0] << 8) | data[1]);
+}
+
+inline quint32 readUInt32(const uint8_t* data)
+{
+	return (quint32(data[0]) << 24) | (quint32(data[1]) << 16) | (quint32(data[2]) << 8) | quint32(data[3]);
+}
+
+///
+/// @brief Find the address of the interface which is in the same network as the sender
+///
+QHostAddress localAddressFor(const QHostAddress& address)
+{
+	for (const auto& interface : QNetworkInterface::allInterfaces())
+	{
+		for (const auto& entry : interface.addressEntries())
+		{
+			if (entry.ip().protocol() == address.protocol() && address.isInSubnet(entry.ip(), entry.prefixLength()))
+			{
+				return entry.ip();
+			}
+		}
+	}
+	return QHostAddress();
+}
+
+}
+
+FlatBufferUdpReceiver::FlatBufferUdpReceiver(QObject* parent)
+	: QObject(parent)
+	, _socket(new QUdpSocket(this))
+	, _netOrigin(NetOrigin::getInstance())
+	, _log(Logger::getInstance("FLATBUFSERVER"))
+	, _timeout(5)
+{
+	connect(_socket, &QUdpSocket::readyRead, this, &FlatBufferUdpReceiver::readPendingDatagrams);
+}
+
+FlatBufferUdpReceiver::~FlatBufferUdpReceiver()
+{
+	stop();
+}
+
+void FlatBufferUdpReceiver::start(quint16 port, int timeout)
+{
+	_timeout = timeout;
+	if (_socket->state() == QAbstractSocket::BoundState && _socket->localPort() == port)
+		return;
+
+	stop();
+	if (!_socket->bind(QHostAddress::Any, port))
+	{
+		Error(_log, "Failed to bind UDP port %d", port);
+		return;
+	}
+	Info(_log, "Started UDP listener on port %d", port);
+}
+
+void FlatBufferUdpReceiver::stop()
+{
+	if (_socket->state() != QAbstractSocket::BoundState)
+		return;
+
+	_socket->close();
+
+	// ends the clients, which removes them from _peers
+	const QHash<PeerKey, Peer> peers = _peers;
+	for (const auto& peer : peers)
+	{
+		peer.client->forceClose();
+	}
+	Info(_log, "Stopped UDP listener");
+}
+
+bool FlatBufferUdpReceiver::isListening() const
+{
+	return _socket->state() == QAbstractSocket::BoundState;
+}
+
+void FlatBufferUdpReceiver::readPendingDatagrams()
+{
+	QHostAddress address;
+	quint16 port;
+
+	while (_socket->hasPendingDatagrams())
+	{
+		const qint64 size = _socket->pendingDatagramSize();
+		if (size > _datagram.size())
+		{
+			_datagram.resize(int(size));
+		}
+
+		const qint64 bytes = _socket->readDatagram(_datagram.data(), size, &address, &port);
+		if (bytes < 0)
+			continue;
+
+		ServerMetrics::addReceivedBytes(ServerMetrics::FLATBUFSERVER, bytes);
+		handleDatagram(address, port, reinterpret_cast<const uint8_t*>(_datagram.constData()), bytes);
+	}
+}
+
+void FlatBufferUdpReceiver::handleDatagram(const QHostAddress& address, quint16 port, const uint8_t* data, qint64 size)
+{
+	if (size < HEADER_SIZE || data[0] != PROTOCOL_VERSION)
+		return;
+
+	const quint16 sequence = readUInt16(data + 2);
+	const quint32 offset = readUInt32(data + 4);
+	const quint32 total = readUInt32(data + 8);
+	const quint32 length = quint32(size - HEADER_SIZE);
+	const uint8_t* fragment = data + HEADER_SIZE;
+
+	if (total == 0 || total > MAX_REQUEST_SIZE || offset >= total || length > total - offset)
+		return;
+
+	Peer* p = peer(address, port);
+	if (p == nullptr)
+		return;
+
+	// drop late frames, a frame which is this old is handled or lost already
+	if (p->hasLast)
+	{
+		const qint16 age = qint16(p->lastSequence - sequence);
+		if (age >= 0 && age < RESYNC_DISTANCE)
+			return;
+	}
+
+	FrameAssembler& assembler = p->assembler;
+	if (assembler.isActive() && sequence != p->sequence)
+	{
+		// a fragment of an older frame than the one in assembly
+		if (qint16(sequence - p->sequence) < 0)
+			return;
+
+		// a newer frame is on its way, do not wait for the rest of the current one
+		assembler.reset();
+		ServerMetrics::addDroppedFrames(ServerMetrics::FLATBUFSERVER, 1);
+	}
+
+	// a request within a single datagram is handled in place
+	if (!assembler.isActive() && offset == 0 && length == total)
+	{
+		p->hasLast = true;
+		p->lastSequence = sequence;
+		p->client->handleDatagramMessage(fragment, total);
+		return;
+	}
+
+	if (!assembler.isActive())
+	{
+		p->sequence = sequence;
+		assembler.start(total);
+	}
+	else if (assembler.total() != total)
+	{
+		// fragments of one frame disagree about its size
+		assembler.reset();
+		ServerMetrics::addDroppedFrames(ServerMetrics::FLATBUFSERVER, 1);
+		return;
+	}
+
+	if (assembler.add(offset, fragment, length) == FrameAssembler::Complete)
+	{
+		p->hasLast = true;
+		p->lastSequence = sequence;
+		p->client->handleDatagramMessage(reinterpret_cast<const uint8_t*>(assembler.frame().constData()), total);
+	}
+}
+
+FlatBufferUdpReceiver::Peer* FlatBufferUdpReceiver::peer(const QHostAddress& address, quint16 port)
+{
+	const PeerKey key(address, port);
+	auto it = _peers.find(key);
+	if (it != _peers.end())
+		return &it.value();
+
+	if (_peers.size() >= MAX_PEERS || !_netOrigin->accessAllowed(address, localAddressFor(address)))
+		return nullptr;
+
+	Debug(_log, "New UDP sender %s:%d", QSTRING_CSTR(address.toString()), port);
+
+	Peer peer;
+	peer.client = new FlatBufferClient(_socket, address, port, _timeout, this);
+	connect(peer.client, &FlatBufferClient::clientDisconnected, this, &FlatBufferUdpReceiver::clientDisconnected);
+
+	it = _peers.insert(key, peer);
+	emit newClient(peer.client);
+	return &it.value();
+}
+
+void FlatBufferUdpReceiver::clientDisconnected()
+{
+	FlatBufferClient* client = qobject_cast<FlatBufferClient*>(sender());
+	if (client == nullptr)
+		return;
+
+	for (auto it = _peers.begin(); it != _peers.end(); ++it)
+	{
+		if (it->client == client)
+		{
+			_peers.erase(it);
+			return;
+		}
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// util
+#include <utils/Logger.h>
+
+// local
+#include "FrameAssembler.h"
+
+// qt
+#include <QObject>
+#include <QHostAddress>
+#include <QByteArray>
+#include <QHash>
+#include <QPair>
+
+class QUdpSocket;
+class FlatBufferClient;
+class NetOrigin;
+
+///
+/// @brief Receives flatbuffer requests via UDP, for senders which prefer a dropped frame to a delayed one
+///
+/// Every datagram starts with a 12 byte header (big endian) followed by a fragment of the request:
+/// version (1 byte, 1), flags (1 byte, 0), frame sequence number (2 bytes), offset of the fragment (4 bytes),
+/// total size of the request (4 bytes). A request is handled once every byte of it arrived exactly once, duplicated
+/// or overlapping fragments are ignored. Fragments of
+/// frames older than the last handled or the currently assembled one are dropped, a newer frame replaces an
+/// incomplete one. Each sender (address and port) is handled by its own FlatBufferClient.
+///
+class FlatBufferUdpReceiver : public QObject
+{
+	Q_OBJECT
+
+public:
+	FlatBufferUdpReceiver(QObject* parent = nullptr);
+	~FlatBufferUdpReceiver() override;
+
+	///
+	/// @brief Start to listen
+	/// @param port     The UDP port
+	/// @param timeout  Senders are removed when they did not send a request for the timeout (in seconds)
+	///
+	void start(quint16 port, int timeout);
+
+	///
+	/// @brief Stop to listen and remove all senders
+	///
+	void stop();
+
+	bool isListening() const;
+
+signals:
+	///
+	/// @brief Emits for every new sender, the client is owned by the receiver
+	///
+	void newClient(FlatBufferClient* client);
+
+private slots:
+	void readPendingDatagrams();
+
+	///
+	/// @brief Remove a sender whose client disconnected (timeout)
+	///
+	void clientDisconnected();
+
+private:
+	/// frame assembly state of a sender
+	struct Peer
+	{
+		FlatBufferClient* client = nullptr;
+		/// the last handled frame
+		bool hasLast = false;
+		quint16 lastSequence = 0;
+		/// the frame in assembly
+		quint16 sequence = 0;
+		FrameAssembler assembler;
+	};
+
+	typedef QPair<QHostAddress, quint16> PeerKey;
+
+	///
+	/// @brief Handle a single datagram
+	///
+	void handleDatagram(const QHostAddress& address, quint16 port, const uint8_t* data, qint64 size);
+
+	///
+	/// @brief Get or create the state of a sender
+	/// @return The state, nullptr if the sender is not allowed
+	///
+	Peer* peer(const QHostAddress& address, quint16 port);
+
+	QUdpSocket* _socket;
+	NetOrigin* _netOrigin;
+	Logger* _log;
+	int _timeout;
+
+	QHash<PeerKey, Peer> _peers;
+
+	/// datagram receive buffer
+	QByteArray _datagram;
+};
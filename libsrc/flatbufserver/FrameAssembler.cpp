@@ -0,0 +1,50 @@
+#include "FrameAssembler.h"
+
+// stl
+#include <cstring>
+#include <iterator>
+
+void FrameAssembler::start(uint32_t total)
+{
+	// keeps the capacity of the previous frame
+	_frame.resize(int(total));
+	_ranges.clear();
+	_received = 0;
+	_isActive = true;
+}
+
+void FrameAssembler::reset()
+{
+	_ranges.clear();
+	_received = 0;
+	_isActive = false;
+}
+
+FrameAssembler::Result FrameAssembler::add(uint32_t offset, const uint8_t* data, uint32_t length)
+{
+	const uint32_t total = uint32_t(_frame.size());
+	if (!_isActive || length == 0 || offset >= total || length > total - offset)
+		return Ignored;
+
+	const uint32_t end = offset + length;
+
+	// the next range must start at or after the end of the fragment
+	auto next = _ranges.lower_bound(offset);
+	if (next != _ranges.end() && next->first < end)
+		return Ignored;
+
+	// the previous range must end at or before the start of the fragment
+	if (next != _ranges.begin() && std::prev(next)->second > offset)
+		return Ignored;
+
+	memcpy(_frame.data() + offset, data, length);
+	_ranges.emplace_hint(next, offset, end);
+	_received += length;
+
+	// the ranges never overlap, so all bytes are covered once their sizes add up to the total
+	if (_received < total)
+		return Incomplete;
+
+	_isActive = false;
+	return Complete;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// stl
+#include <cstdint>
+#include <map>
+
+// qt
+#include <QByteArray>
+
+///
+/// @brief Reassembles a request from the fragments of UDP datagrams
+///
+/// The fragments may arrive in any order. A fragment which overlaps one received already (e.g. a
+/// retransmitted datagram) is ignored, so the frame is complete only when every byte was received exactly once.
+///
+class FrameAssembler
+{
+public:
+	enum Result
+	{
+		/// fragments are missing
+		Incomplete,
+		/// all bytes of the frame were received, see frame()
+		Complete,
+		/// the fragment overlaps a received one or is outside of the frame, it was ignored
+		Ignored
+	};
+
+	///
+	/// @brief Start to assemble a new frame, the previous one is dropped
+	/// @param total  The size of the frame
+	///
+	void start(uint32_t total);
+
+	///
+	/// @brief Drop the frame in assembly
+	///
+	void reset();
+
+	///
+	/// @brief Add a fragment of the frame in assembly
+	/// @param offset  The offset of the fragment in the frame
+	/// @param data    The fragment
+	/// @param length  The size of the fragment
+	/// @return The state of the frame
+	///
+	Result add(uint32_t offset, const uint8_t* data, uint32_t length);
+
+	/// @return True, if a frame is in assembly
+	bool isActive() const { return _isActive; }
+
+	/// @return The size of the frame in assembly
+	uint32_t total() const { return uint32_t(_frame.size()); }
+
+	/// @return The frame, all bytes are valid once add() returned Complete
+	const QByteArray& frame() const { return _frame; }
+
+private:
+	QByteArray _frame;
+	/// start and end of the received ranges, which never overlap
+	std::map<uint32_t, uint32_t> _ranges;
+	uint32_t _received = 0;
+	bool _isActive = false;
+};
@@ -6,12 +6,14 @@
 #include <QString>
 #include <QStringList>
 #include <QThread>
+#include <QTimer>
 
 // hyperion include
 #include <hyperion/Hyperion.h>
 #include <hyperion/MessageForwarder.h>
 #include <hyperion/ImageProcessor.h>
 #include <hyperion/ColorAdjustment.h>
+#include <hyperion/StreamPublisher.h>
 
 // utils
 #include <utils/hyperion.h>
@@ -44,6 +46,7 @@ Hyperion::Hyperion(quint8 instance)
 	, _instIndex(instance)
 	, _settingsManager(new SettingsManager(instance, this))
 	, _componentRegister(this)
+	, _metrics(QSharedPointer<PipelineMetrics>::create())
 	, _ledString(hyperion::createLedString(getSetting(settings::LEDS).array(), hyperion::createColorOrder(getSetting(settings::DEVICE).object())))
 	, _imageProcessor(new ImageProcessor(_ledString, this))
 	, _muxer(_ledString.leds().size(), this)
@@ -54,6 +57,13 @@ Hyperion::Hyperion(quint8 instance)
 	, _hwLedCount()
 	, _ledGridSize(hyperion::getLedLayoutGridSize(getSetting(settings::LEDS).array()))
 	, _ledBuffer(_ledString.leds().size(), ColorRgb::BLACK)
+	, _isHighPrecision(false)
+	, _streamPublisher(nullptr)
+	, _renderTimer(nullptr)
+	, _renderInterval_ns(0)
+	, _nextRenderTime_ns(0)
+	, _renderPending(false)
+	, _inputTime_us(0)
 {
 
 }
@@ -79,6 +89,9 @@ void Hyperion::start()
 	// handle hwLedCount
 	_hwLedCount = qMax(unsigned(getSetting(settings::DEVICE).object()["hardwareLedCount"].toInt(getLedCount())), getLedCount());
 
+	// 16 bit adjustment and smoothing, dithered to 8 bit by the device
+	_isHighPrecision = getSetting(settings::DEVICE).object()["dithering"].toBool(false);
+
 	// init colororder vector
 	for (const Led& led : _ledString.leds())
 	{
@@ -105,6 +118,7 @@ void Hyperion::start()
 	_ledDeviceWrapper = new LedDeviceWrapper(this);
 	connect(this, &Hyperion::compStateChangeRequest, _ledDeviceWrapper, &LedDeviceWrapper::handleComponentState);
 	connect(this, &Hyperion::ledDeviceData, _ledDeviceWrapper, &LedDeviceWrapper::updateLeds);
+	connect(this, &Hyperion::ledDeviceData16, _ledDeviceWrapper, &LedDeviceWrapper::updateLeds16);
 	_ledDeviceWrapper->createLedDevice(ledDevice);
 
 	// smoothing
@@ -134,6 +148,16 @@ void Hyperion::start()
 	connect(GlobalSignals::getInstance(), &GlobalSignals::setGlobalColor, this, &Hyperion::setColor);
 	connect(GlobalSignals::getInstance(), &GlobalSignals::setGlobalImage, this, &Hyperion::setInputImage);
 
+	// live image stream for all clients
+	_streamPublisher = new StreamPublisher(this);
+
+	// optional fixed-rate render loop, configured with the smoothing settings
+	_renderTimer = new QTimer(this);
+	_renderTimer->setTimerType(Qt::PreciseTimer);
+	_renderTimer->setSingleShot(true);
+	connect(_renderTimer, &QTimer::timeout, this, &Hyperion::handleRenderTick);
+	updateRenderLoop(getSetting(settings::SMOOTHING).object());
+
 	// if there is no startup / background eff and no sending capture interface we probably want to push once BLACK (as PrioMuxer won't emit a prioritiy change)
 	update();
 
@@ -164,6 +188,7 @@ void Hyperion::freeObjects()
 	delete _messageForwarder;
 	delete _settingsManager;
 	delete _ledDeviceWrapper;
+	delete _streamPublisher;
 }
 
 void Hyperion::handleSettingsUpdate(settings::type type, const QJsonDocument& config)
@@ -222,6 +247,8 @@ void Hyperion::handleSettingsUpdate(settings::type type, const QJsonDocument& co
 		// handle hwLedCount update
 		_hwLedCount = qMax(unsigned(dev["hardwareLedCount"].toInt(getLedCount())), getLedCount());
 
+		_isHighPrecision = dev["dithering"].toBool(false);
+
 		// force ledString update, if device ByteOrder changed
 		if(_ledDeviceWrapper->getColorOrder() != dev["colorOrder"].toString("rgb"))
 		{
@@ -244,6 +271,7 @@ void Hyperion::handleSettingsUpdate(settings::type type, const QJsonDocument& co
 	else if(type == settings::SMOOTHING)
 	{
 		_deviceSmooth->handleSettingsUpdate( type, config);
+		updateRenderLoop(config.object());
 	}
 
 	// update once to push single color sets / adjustments/ ledlayout resizes and update ledBuffer color
@@ -326,6 +354,8 @@ bool Hyperion::setInput(int priority, const std::vector<ColorRgb>& ledColors, in
 		// if this priority is visible, update immediately
 		if(priority == _muxer.getCurrentPriority())
 		{
+			if (_inputTime_us == 0)
+				_inputTime_us = PipelineMetrics::now_us();
 			update();
 		}
 
@@ -351,6 +381,8 @@ bool Hyperion::setInputImage(int priority, const Image<ColorRgb>& image, int64_t
 		// if this priority is visible, update immediately
 		if(priority == _muxer.getCurrentPriority())
 		{
+			if (_inputTime_us == 0)
+				_inputTime_us = PipelineMetrics::now_us();
 			update();
 		}
 
@@ -523,6 +555,93 @@ QString Hyperion::getActiveDeviceType() const
 	return _ledDeviceWrapper->getActiveDeviceType();
 }
 
+Hyperion::RenderTimings Hyperion::getRenderTimings() const
+{
+	RenderTimings timings = _renderTimings;
+	timings.write_us = _ledDeviceWrapper->getLastWriteDuration();
+	timings.frames = static_cast<quint64>(_metrics->counter(PipelineMetrics::FRAMES_RENDERED));
+	timings.skipped = static_cast<quint64>(_metrics->counter(PipelineMetrics::FRAMES_SKIPPED));
+	return timings;
+}
+
+bool Hyperion::isRenderLoopActive() const
+{
+	return _renderInterval_ns > 0;
+}
+
+void Hyperion::updateRenderLoop(const QJsonObject& config)
+{
+	const bool enable = config["renderLoop"].toBool(false);
+	const double frequency = config["renderFrequency"].toDouble(60.0);
+
+	if (!enable || frequency <= 0.0)
+	{
+		if (_renderInterval_ns > 0)
+			Info(_log, "Render loop stopped, leds are updated on new input");
+
+		_renderTimer->stop();
+		_renderInterval_ns = 0;
+
+		// pending input would be lost otherwise
+		if (_renderPending)
+		{
+			_renderPending = false;
+			render();
+		}
+		return;
+	}
+
+	const qint64 interval_ns = static_cast<qint64>(1000000000.0 / frequency);
+	if (interval_ns == _renderInterval_ns)
+		return;
+
+	Info(_log, "Render loop started with %.2f Hz", frequency);
+	_renderInterval_ns = interval_ns;
+	_renderClock.start();
+	_nextRenderTime_ns = _renderInterval_ns;
+	_renderPending = true;
+	scheduleRenderTick();
+}
+
+void Hyperion::scheduleRenderTick()
+{
+	const qint64 remaining_ns = _nextRenderTime_ns - _renderClock.nsecsElapsed();
+	// rounded up, the tick must not come before the frame is due
+	_renderTimer->start(static_cast<int>(qMax(Q_INT64_C(0), (remaining_ns + 999999) / 1000000)));
+}
+
+void Hyperion::handleRenderTick()
+{
+	// rendering on demand, the inputs since the last frame are coalesced
+	if (_renderInterval_ns <= 0)
+	{
+		if (_renderPending)
+		{
+			_renderPending = false;
+			render();
+		}
+		return;
+	}
+
+	// drop all ticks we missed entirely instead of catching up with a burst of frames
+	const qint64 lateness_ns = _renderClock.nsecsElapsed() - _nextRenderTime_ns;
+	if (lateness_ns >= _renderInterval_ns)
+	{
+		const qint64 missed = lateness_ns / _renderInterval_ns;
+		_metrics->increment(PipelineMetrics::FRAMES_SKIPPED, missed);
+		_nextRenderTime_ns += missed * _renderInterval_ns;
+	}
+	_nextRenderTime_ns += _renderInterval_ns;
+
+	if (_renderPending)
+	{
+		_renderPending = false;
+		render();
+	}
+
+	scheduleRenderTick();
+}
+
 void Hyperion::handleVisibleComponentChanged(hyperion::Components comp)
 {
 	_imageProcessor->setBlackbarDetectDisable((comp == hyperion::COMP_EFFECT));
@@ -532,32 +651,35 @@ void Hyperion::handleVisibleComponentChanged(hyperion::Components comp)
 
 void Hyperion::update()
 {
-	// Obtain the current priority channel
-	int priority = _muxer.getCurrentPriority();
-	const PriorityMuxer::InputInfo priorityInfo = _muxer.getInputInfo(priority);
-
-	// copy image & process OR copy ledColors from muxer
-	Image<ColorRgb> image = priorityInfo.image;
-	if(image.size() > 3)
-	{
-		emit currentImage(image);
-		_ledBuffer = _imageProcessor->process(image);
-	}
-	else
+	// not started yet
+	if (_renderTimer == nullptr)
 	{
-		_ledBuffer = priorityInfo.ledColors;
+		render();
+		return;
 	}
 
-	// emit rawLedColors before transform
-	emit rawLedColors(_ledBuffer);
+	// the render loop samples the muxer on its next tick
+	_renderPending = true;
+
+	// without render loop all inputs already queued to this instance are rendered as one frame,
+	// the zero timer fires once the pending events are processed
+	if (_renderInterval_ns <= 0 && !_renderTimer->isActive())
+		_renderTimer->start(0);
+}
 
-	_raw2ledAdjustment->applyAdjustment(_ledBuffer);
+namespace {
 
+///
+/// @brief Correct the color byte order of every led
+///
+template <typename Color>
+void applyColorOrder(std::vector<Color>& ledColors, const std::vector<ColorOrder>& colorOrder)
+{
 	int i = 0;
-	for (ColorRgb& color : _ledBuffer)
+	for (Color& color : ledColors)
 	{
 		// correct the color byte order
-		switch (_ledStringColorOrder.at(i))
+		switch (colorOrder.at(i))
 		{
 		case ColorOrder::ORDER_RGB:
 			// leave as it is
@@ -583,21 +705,76 @@ void Hyperion::update()
 		}
 		i++;
 	}
+}
+
+}
+
+void Hyperion::render()
+{
+	QElapsedTimer stageTimer;
+
+	// Obtain the current priority channel
+	int priority = _muxer.getCurrentPriority();
+	const PriorityMuxer::InputInfo priorityInfo = _muxer.getInputInfo(priority);
 
-	// fill additional hw leds with black
-	if ( _hwLedCount > _ledBuffer.size() )
+	// copy image & process OR copy ledColors from muxer
+	Image<ColorRgb> image = priorityInfo.image;
+	if(image.size() > 3)
 	{
-		_ledBuffer.resize(_hwLedCount, ColorRgb::BLACK);
+		emit currentImage(image);
+		stageTimer.start();
+		_ledBuffer = _imageProcessor->process(image);
+		_renderTimings.map_us = stageTimer.nsecsElapsed() / 1000;
 	}
+	else
+	{
+		_ledBuffer = priorityInfo.ledColors;
+		_renderTimings.map_us = 0;
+	}
+
+	// emit rawLedColors before transform
+	emit rawLedColors(_ledBuffer);
+
+	stageTimer.start();
+	if (_isHighPrecision)
+	{
+		_raw2ledAdjustment->applyAdjustment(_ledBuffer, _ledBuffer16);
+		applyColorOrder(_ledBuffer16, _ledStringColorOrder);
+
+		// fill additional hw leds with black
+		if ( _hwLedCount > _ledBuffer16.size() )
+		{
+			_ledBuffer16.resize(_hwLedCount, ColorRgb16{0, 0, 0});
+		}
+	}
+	else
+	{
+		_raw2ledAdjustment->applyAdjustment(_ledBuffer);
+		applyColorOrder(_ledBuffer, _ledStringColorOrder);
+
+		// fill additional hw leds with black
+		if ( _hwLedCount > _ledBuffer.size() )
+		{
+			_ledBuffer.resize(_hwLedCount, ColorRgb::BLACK);
+		}
+	}
+	_renderTimings.adjust_us = stageTimer.nsecsElapsed() / 1000;
+	_metrics->record(PipelineMetrics::ADJUST, _renderTimings.adjust_us);
+	_metrics->increment(PipelineMetrics::FRAMES_RENDERED);
 
 	// Write the data to the device
 	if (_ledDeviceWrapper->enabled())
 	{
+		stageTimer.start();
+
 		// Smoothing is disabled
 		if  (! _deviceSmooth->enabled())
 		{
 			//std::cout << "Hyperion::update()> Non-Smoothing - "; LedDevice::printLedValues ( _ledBuffer);
-			emit ledDeviceData(_ledBuffer);
+			if (_isHighPrecision)
+				emit ledDeviceData16(_ledBuffer16);
+			else
+				emit ledDeviceData(_ledBuffer);
 		}
 		else
 		{
@@ -606,10 +783,20 @@ void Hyperion::update()
 			// feed smoothing in pause mode to maintain a smooth transistion back to smooth mode
 			if (_deviceSmooth->enabled() || _deviceSmooth->pause())
 			{
-				_deviceSmooth->updateLedValues(_ledBuffer);
+				if (_isHighPrecision)
+					_deviceSmooth->updateLedValues(_ledBuffer16);
+				else
+					_deviceSmooth->updateLedValues(_ledBuffer);
 			}
 		}
+		_renderTimings.smooth_us = stageTimer.nsecsElapsed() / 1000;
+
+		if (_inputTime_us > 0)
+		{
+			_metrics->record(PipelineMetrics::LATENCY, PipelineMetrics::now_us() - _inputTime_us);
+		}
 	}
+	_inputTime_us = 0;
 	//else
 	//{
 	//	/LEDDevice is disabled
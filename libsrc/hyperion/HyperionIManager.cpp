@@ -6,6 +6,7 @@
 
 // qt
 #include <QThread>
+#include <QMutexLocker>
 
 HyperionIManager* HyperionIManager::HIMinstance;
 
@@ -28,6 +29,12 @@ Hyperion* HyperionIManager::getHyperionInstance(quint8 instance)
 	return _runningInstances.value(0);
 }
 
+QMap<quint8, HyperionIManager::InstanceMetrics> HyperionIManager::getInstanceMetrics() const
+{
+	QMutexLocker lock(&_metricsMutex);
+	return _instanceMetrics;
+}
+
 QVector<QVariantMap> HyperionIManager::getInstanceData() const
 {
 	QVector<QVariantMap> instances = _instanceTable->getAllInstances();
@@ -180,6 +187,11 @@ bool HyperionIManager::saveName(quint8 inst, const QString& name)
 {
 	if(_instanceTable->saveName(inst, name))
 	{
+		{
+			QMutexLocker lock(&_metricsMutex);
+			if(_instanceMetrics.contains(inst))
+				_instanceMetrics[inst].name = name;
+		}
 		emit change();
 		return true;
 	}
@@ -194,6 +206,10 @@ void HyperionIManager::handleFinished()
 	Info(_log,"Hyperion instance '%s' has been stopped", QSTRING_CSTR(_instanceTable->getNamebyIndex(instance)));
 
 	_runningInstances.remove(instance);
+	{
+		QMutexLocker lock(&_metricsMutex);
+		_instanceMetrics.remove(instance);
+	}
 	hyperion->thread()->deleteLater();
 	hyperion->deleteLater();
 	emit instanceStateChanged(InstanceState::H_STOPPED, instance);
@@ -209,6 +225,10 @@ void HyperionIManager::handleStarted()
 
 	_startQueue.removeAll(instance);
 	_runningInstances.insert(instance, hyperion);
+	{
+		QMutexLocker lock(&_metricsMutex);
+		_instanceMetrics.insert(instance, { _instanceTable->getNamebyIndex(instance), hyperion->getSharedMetrics() });
+	}
 	emit instanceStateChanged(InstanceState::H_STARTED, instance);
 	emit change();
 }
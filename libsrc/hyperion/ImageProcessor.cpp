@@ -36,6 +36,7 @@ ImageProcessor::ImageProcessor(const LedString& ledString, Hyperion* hyperion)
 	, _userMappingType(0)
 	, _hardMappingType(0)
 	, _hyperion(hyperion)
+	, _metrics(&hyperion->getMetrics())
 {
 	// init
 	handleSettingsUpdate(settings::COLOR, _hyperion->getSetting(settings::COLOR));
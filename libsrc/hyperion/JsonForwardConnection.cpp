@@ -0,0 +1,128 @@
+#include "JsonForwardConnection.h"
+
+// Qt includes
+#include <QTcpSocket>
+#include <QTimer>
+#include <QJsonDocument>
+
+// utils includes
+#include <utils/Logger.h>
+#include <utils/PipelineMetrics.h>
+
+namespace {
+
+/// Messages waiting for a connection or for the in-flight window, the oldest is dropped beyond
+const int MAX_QUEUED_MESSAGES = 32;
+/// Messages written without having received their reply yet
+const int MAX_IN_FLIGHT_MESSAGES = 16;
+/// Interval to retry the connection to an unreachable target
+const int RECONNECT_INTERVAL_MS = 5000;
+
+}
+
+JsonForwardConnection::JsonForwardConnection(const QString& address, QObject* parent)
+	: QObject(parent)
+	, _log(Logger::getInstance("NETFORWARDER"))
+	, _address(address)
+	, _port(0)
+	, _socket(new QTcpSocket(this))
+	, _reconnectTimer(new QTimer(this))
+	, _isConnected(false)
+	, _sent(0)
+	, _dropped(0)
+{
+	const QStringList parts = address.split(":");
+	if (parts.size() == 2)
+	{
+		_host = parts[0];
+		_port = parts[1].toUShort();
+	}
+
+	_socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+	connect(_socket, &QTcpSocket::connected, this, &JsonForwardConnection::connected);
+	connect(_socket, &QTcpSocket::disconnected, this, &JsonForwardConnection::disconnected);
+	connect(_socket, &QTcpSocket::readyRead, this, &JsonForwardConnection::readReplies);
+
+	_reconnectTimer->setInterval(RECONNECT_INTERVAL_MS);
+	connect(_reconnectTimer, &QTimer::timeout, this, &JsonForwardConnection::connectToHost);
+}
+
+QJsonObject JsonForwardConnection::getStatistics() const
+{
+	QJsonObject stats;
+	stats["connected"] = _isConnected.load(std::memory_order_relaxed);
+	stats["sent"] = static_cast<qint64>(_sent.load(std::memory_order_relaxed));
+	stats["dropped"] = static_cast<qint64>(_dropped.load(std::memory_order_relaxed));
+	stats["latency"] = _latency.toJson();
+	return stats;
+}
+
+void JsonForwardConnection::sendMessage(const QJsonObject& message)
+{
+	// for hyperion classic compatibility
+	QJsonObject jsonMessage = message;
+	if (jsonMessage.contains("tan") && jsonMessage["tan"].isNull())
+		jsonMessage["tan"] = 100;
+
+	if (_queue.size() >= MAX_QUEUED_MESSAGES)
+	{
+		_queue.dequeue();
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+	}
+	_queue.enqueue(QJsonDocument(jsonMessage).toJson(QJsonDocument::Compact) + "\n");
+
+	writePending();
+}
+
+void JsonForwardConnection::connectToHost()
+{
+	if (!_reconnectTimer->isActive())
+		_reconnectTimer->start();
+
+	if (_socket->state() == QAbstractSocket::UnconnectedState)
+		_socket->connectToHost(_host, _port);
+}
+
+void JsonForwardConnection::connected()
+{
+	Info(_log, "Connected to json target %s", QSTRING_CSTR(_address));
+	_isConnected.store(true, std::memory_order_relaxed);
+	_inFlight.clear();
+	writePending();
+}
+
+void JsonForwardConnection::disconnected()
+{
+	Warning(_log, "Lost connection to json target %s", QSTRING_CSTR(_address));
+	_isConnected.store(false, std::memory_order_relaxed);
+
+	// the replies of written messages will never arrive, the queued ones are sent after reconnect
+	_inFlight.clear();
+}
+
+void JsonForwardConnection::readReplies()
+{
+	// every reply is terminated by a newline, replies arrive in the order of the messages
+	const QByteArray replies = _socket->readAll();
+	const int64_t now = PipelineMetrics::now_us();
+	for (const char c : replies)
+	{
+		if (c == '\n' && !_inFlight.isEmpty())
+			_latency.record(now - _inFlight.dequeue());
+	}
+
+	writePending();
+}
+
+void JsonForwardConnection::writePending()
+{
+	if (_socket->state() != QAbstractSocket::ConnectedState)
+		return;
+
+	while (!_queue.isEmpty() && _inFlight.size() < MAX_IN_FLIGHT_MESSAGES)
+	{
+		_socket->write(_queue.dequeue());
+		_inFlight.enqueue(PipelineMetrics::now_us());
+		_sent.fetch_add(1, std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+// STL includes
+#include <atomic>
+#include <cstdint>
+
+// Qt includes
+#include <QObject>
+#include <QQueue>
+#include <QByteArray>
+#include <QJsonObject>
+
+// utils includes
+#include <utils/LatencyHistogram.h>
+
+class QTcpSocket;
+class QTimer;
+class Logger;
+
+///
+/// @brief Persistent connection to a single json forwarding target
+///
+/// The connection lives in the forwarder thread and reconnects on its own when the target goes away.
+/// Messages are queued via sendMessage() and written without waiting for the reply of the previous message.
+/// The outgoing queue is bounded, the oldest message is dropped when the target does not keep up.
+/// Statistics are kept in atomics and can be read from any thread.
+///
+class JsonForwardConnection : public QObject
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @brief Constructor
+	/// @param address The target as <host>:<port>
+	/// @param parent  The parent object
+	///
+	JsonForwardConnection(const QString& address, QObject* parent = nullptr);
+
+	///
+	/// @brief The target as given to the constructor
+	///
+	const QString& getAddress() const { return _address; }
+
+	///
+	/// @brief Statistics of this connection, can be called from any thread
+	/// @return Object with connected state, sent/dropped messages and the reply latency
+	///
+	QJsonObject getStatistics() const;
+
+public slots:
+	///
+	/// @brief Queue a message and write it when connected
+	/// @param message The JSON message to send
+	///
+	void sendMessage(const QJsonObject& message);
+
+	///
+	/// @brief Connect to the target if currently not connected
+	///
+	void connectToHost();
+
+private slots:
+	void connected();
+	void disconnected();
+
+	///
+	/// @brief Match the received replies with the in-flight messages
+	///
+	void readReplies();
+
+private:
+	///
+	/// @brief Write queued messages as long as the in-flight limit allows
+	///
+	void writePending();
+
+	/// Logger instance
+	Logger* _log;
+
+	/// Target as <host>:<port>
+	QString _address;
+	QString _host;
+	quint16 _port;
+
+	QTcpSocket* _socket;
+	QTimer* _reconnectTimer;
+
+	/// Serialized messages waiting to be written
+	QQueue<QByteArray> _queue;
+	/// Send timestamps of messages which are still waiting for the reply
+	QQueue<int64_t> _inFlight;
+
+	std::atomic<bool> _isConnected;
+	std::atomic<uint64_t> _sent;
+	std::atomic<uint64_t> _dropped;
+	LatencyHistogram _latency;
+};
@@ -21,6 +21,8 @@ LinearColorSmoothing::LinearColorSmoothing(const QJsonDocument& config, Hyperion
 	, _updateInterval(DEFAUL_UPDATEINTERVALL)
 	, _settlingTime(DEFAUL_SETTLINGTIME)
 	, _timer(new QTimer(this))
+	, _previousTick_us(0)
+	, _isHighPrecision(false)
 	, _outputDelay(DEFAUL_OUTPUTDEPLAY)
 	, _writeToLedsEnable(false)
 	, _continuousOutput(false)
@@ -77,17 +79,18 @@ void LinearColorSmoothing::handleSettingsUpdate(settings::type type, const QJson
 	}
 }
 
-int LinearColorSmoothing::write(const std::vector<ColorRgb> &ledValues)
+template <typename Color>
+int LinearColorSmoothing::write(const std::vector<Color> &ledValues, std::vector<Color>& targetValues, std::vector<Color>& previousValues)
 {
 	_targetTime = QDateTime::currentMSecsSinceEpoch() + _settlingTime;
-	_targetValues = ledValues;
+	targetValues = ledValues;
 
 	// received a new target color
-	if (_previousValues.empty())
+	if (previousValues.empty())
 	{
 		// not initialized yet
 		_previousTime = QDateTime::currentMSecsSinceEpoch();
-		_previousValues = ledValues;
+		previousValues = ledValues;
 
 		//Debug( _log, "Start Smoothing timer: settlingTime: %d ms, interval: %d ms (%u Hz), updateDelay: %u frames", _settlingTime, _updateInterval, unsigned(1000.0/_updateInterval), _outputDelay );
 		QMetaObject::invokeMethod(_timer, "start", Qt::QueuedConnection, Q_ARG(int, _updateInterval));
@@ -105,39 +108,79 @@ int LinearColorSmoothing::updateLedValues(const std::vector<ColorRgb>& ledValues
 	}
 	else
 	{
-		retval = write(ledValues);
+		_isHighPrecision = false;
+		retval = write(ledValues, _targetValues, _previousValues);
+	}
+	return retval;
+}
+
+int LinearColorSmoothing::updateLedValues(const std::vector<ColorRgb16>& ledValues)
+{
+	int retval = 0;
+	if (!_enabled)
+	{
+		return -1;
+	}
+	else
+	{
+		_isHighPrecision = true;
+		retval = write(ledValues, _targetValues16, _previousValues16);
 	}
 	return retval;
 }
 
 void LinearColorSmoothing::updateLeds()
 {
+	PipelineStageTimer stageTimer(&_hyperion->getMetrics(), PipelineMetrics::SMOOTH);
+
+	// deviation of the tick from its interval, gaps caused by a stopped timer are not taken into account
+	const int64_t tick_us = PipelineMetrics::now_us();
+	const int64_t interval_us = _updateInterval * 1000;
+	if (_previousTick_us > 0 && tick_us - _previousTick_us < 4 * interval_us)
+	{
+		_hyperion->getMetrics().record(PipelineMetrics::SMOOTH_JITTER, qAbs(tick_us - _previousTick_us - interval_us));
+	}
+	_previousTick_us = tick_us;
+
 	int64_t now = QDateTime::currentMSecsSinceEpoch();
 	int64_t deltaTime = _targetTime - now;
 
 	//Debug(_log, "elapsed Time [%d], _targetTime [%d] - now [%d], deltaTime [%d]", now -_previousTime, _targetTime, now, deltaTime);
+	if (_isHighPrecision)
+	{
+		updateColors(now, deltaTime, _targetValues16, _previousValues16, _outputQueue16);
+	}
+	else
+	{
+		updateColors(now, deltaTime, _targetValues, _previousValues, _outputQueue);
+	}
+}
+
+template <typename Color>
+void LinearColorSmoothing::updateColors(int64_t now, int64_t deltaTime, const std::vector<Color>& targetValues, std::vector<Color>& previousValues, std::list<std::vector<Color>>& outputQueue)
+{
 	if (deltaTime < 0)
 	{
-		_previousValues = _targetValues;
+		previousValues = targetValues;
 		_previousTime = now;
 
-		queueColors(_previousValues);
+		queueColors(previousValues, outputQueue);
 		_writeToLedsEnable = _continuousOutput;
 	}
 	else
 	{
 		_writeToLedsEnable = true;
 
-		//std::cout << "LinearColorSmoothing::updateLeds> _previousValues: "; LedDevice::printLedValues ( _previousValues );
+		//std::cout << "LinearColorSmoothing::updateLeds> _previousValues: "; LedDevice::printLedValues ( previousValues );
 
 		float k = 1.0f - 1.0f * deltaTime / (_targetTime - _previousTime);
 
 		int reddif = 0, greendif = 0, bluedif = 0;
 
-		for (size_t i = 0; i < _previousValues.size(); ++i)
+		for (size_t i = 0; i < previousValues.size(); ++i)
 		{
-			ColorRgb & prev   = _previousValues[i];
-			ColorRgb & target = _targetValues[i];
+			Color & prev   = previousValues[i];
+			const Color & target = targetValues[i];
 
 			reddif   = target.red   - prev.red;
 			greendif = target.green - prev.green;
@@ -149,13 +192,14 @@ void LinearColorSmoothing::updateLeds()
 		}
 		_previousTime = now;
 
-		//std::cout << "LinearColorSmoothing::updateLeds> _targetValues: "; LedDevice::printLedValues ( _targetValues );
+		//std::cout << "LinearColorSmoothing::updateLeds> _targetValues: "; LedDevice::printLedValues ( targetValues );
 
-		queueColors(_previousValues);
+		queueColors(previousValues, outputQueue);
 	}
 }
 
-void LinearColorSmoothing::queueColors(const std::vector<ColorRgb> & ledColors)
+template <typename Color>
+void LinearColorSmoothing::queueColors(const std::vector<Color> & ledColors, std::list<std::vector<Color>>& outputQueue)
 {
 	//Debug(_log, "queueColors -  _outputDelay[%d] _outputQueue.size() [%d], _writeToLedsEnable[%d]", _outputDelay, _outputQueue.size(), _writeToLedsEnable);
 	if (_outputDelay == 0)
@@ -166,36 +210,48 @@ void LinearColorSmoothing::queueColors(const std::vector<ColorRgb> & ledColors)
 //			if ( ledColors.size() == 0 )
 //				qFatal ("No LedValues! - in LinearColorSmoothing::queueColors() - _outputDelay == 0");
 //			else
-			emit _hyperion->ledDeviceData(ledColors);
+			emitLedDeviceData(ledColors);
 		}
 	}
 	else
 	{
 		// Push new colors in the delay-buffer
 		if ( _writeToLedsEnable )
-			_outputQueue.push_back(ledColors);
+			outputQueue.push_back(ledColors);
 
 		// If the delay-buffer is filled pop the front and write to device
-		if (_outputQueue.size() > 0 )
+		if (outputQueue.size() > 0 )
 		{
-			if ( _outputQueue.size() > _outputDelay || !_writeToLedsEnable )
+			if ( outputQueue.size() > _outputDelay || !_writeToLedsEnable )
 			{
 				if (!_pause)
 				{
-					emit _hyperion->ledDeviceData(_outputQueue.front());
+					emitLedDeviceData(outputQueue.front());
 				}
-				_outputQueue.pop_front();
+				outputQueue.pop_front();
 			}
 		}
 	}
 }
 
+void LinearColorSmoothing::emitLedDeviceData(const std::vector<ColorRgb> & ledColors)
+{
+	emit _hyperion->ledDeviceData(ledColors);
+}
+
+void LinearColorSmoothing::emitLedDeviceData(const std::vector<ColorRgb16> & ledColors)
+{
+	emit _hyperion->ledDeviceData16(ledColors);
+}
+
 void LinearColorSmoothing::clearQueuedColors()
 {
 	QMetaObject::invokeMethod(_timer, "stop", Qt::QueuedConnection);
 	_previousValues.clear();
+	_previousValues16.clear();
 
 	_targetValues.clear();
+	_targetValues16.clear();
 }
 
 void LinearColorSmoothing::componentStateChange(hyperion::Components component, bool state)
@@ -8,6 +8,7 @@
 
 // hyperion incluse
 #include <leddevice/LedDevice.h>
+#include <utils/ColorRgb16.h>
 #include <utils/Components.h>
 
 // settings
@@ -39,6 +40,14 @@ public:
 	///
 	virtual int updateLedValues(const std::vector<ColorRgb>& ledValues);
 
+	/// LED values with 16 bit precision as input for the smoothing filter,
+	/// the smoothed values are emitted with Hyperion::ledDeviceData16()
+	///
+	/// @param ledValues The color-value per led
+	/// @return Zero on success else negative
+	///
+	int updateLedValues(const std::vector<ColorRgb16>& ledValues);
+
 	void setEnable(bool enable);
 	void setPause(bool pause);
 	bool pause() const { return _pause; }
@@ -97,20 +106,41 @@ private slots:
 
 private:
 
+	/**
+	 * Moves the previous colors towards the target colors and queues them
+	 *
+	 * @param now The current timestamp
+	 * @param deltaTime The time left until the target colors are to be reached
+	 * @param targetValues The target colors
+	 * @param previousValues The previously written colors, updated in place
+	 * @param outputQueue The output queue of the colors' precision
+	 */
+	template <typename Color>
+	void updateColors(int64_t now, int64_t deltaTime, const std::vector<Color>& targetValues, std::vector<Color>& previousValues, std::list<std::vector<Color>>& outputQueue);
+
 	/**
 	 * Pushes the colors into the output queue and popping the head to the led-device
 	 *
 	 * @param ledColors The colors to queue
+	 * @param outputQueue The output queue of the colors' precision
 	 */
-	void queueColors(const std::vector<ColorRgb> & ledColors);
+	template <typename Color>
+	void queueColors(const std::vector<Color> & ledColors, std::list<std::vector<Color>>& outputQueue);
 	void clearQueuedColors();
 
+	/// Emit the colors to the led-device, with the signal of their precision
+	void emitLedDeviceData(const std::vector<ColorRgb> & ledColors);
+	void emitLedDeviceData(const std::vector<ColorRgb16> & ledColors);
+
 	/// write updated values as input for the smoothing filter
 	///
 	/// @param ledValues The color-value per led
+	/// @param targetValues The target colors of the values' precision
+	/// @param previousValues The previously written colors of the values' precision
 	/// @return Zero on success else negative
 	///
-	virtual int write(const std::vector<ColorRgb> &ledValues);
+	template <typename Color>
+	int write(const std::vector<Color> &ledValues, std::vector<Color>& targetValues, std::vector<Color>& previousValues);
 
 	/// Logger instance
 	Logger* _log;
@@ -136,13 +166,25 @@ private:
 	/// The timestamp of the previously written led data
 	int64_t _previousTime;
 
+	/// The monotonic timestamp of the previous timer tick to measure the jitter with (usec)
+	int64_t _previousTick_us;
+
 	/// The previously written led data
 	std::vector<ColorRgb> _previousValues;
 
+	/// The target and the previously written led data with 16 bit precision
+	std::vector<ColorRgb16> _targetValues16;
+	std::vector<ColorRgb16> _previousValues16;
+
+	/// Smooth the 16 bit values, the input precision of the last values wins
+	bool _isHighPrecision;
+
 	/// The number of updates to keep in the output queue (delayed) before being output
 	unsigned _outputDelay;
 	/// The output queue
 	std::list<std::vector<ColorRgb> > _outputQueue;
+	/// The output queue with 16 bit precision
+	std::list<std::vector<ColorRgb16> > _outputQueue16;
 
 	/// Prevent sending data to device when no intput data is sent
 	bool _writeToLedsEnable;
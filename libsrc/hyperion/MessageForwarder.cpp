@@ -11,19 +11,25 @@
 #include <utils/Logger.h>
 
 // qt includes
-#include <QTcpServer>
-#include <QTcpSocket>
+#include <QThread>
 
 #include <flatbufserver/FlatBufferConnection.h>
 
+#include "JsonForwardConnection.h"
+
 MessageForwarder::MessageForwarder(Hyperion *hyperion)
 	: QObject()
 	, _hyperion(hyperion)
 	, _log(Logger::getInstance("NETFORWARDER"))
 	, _muxer(_hyperion->getMuxerInstance())
+	, _forwardThread(new QThread(this))
 	, _forwarder_enabled(true)
 	, _priority(140)
 {
+	// json targets are served off the instance thread, a target which is down must never block it
+	_forwardThread->setObjectName("NetForwarder");
+	_forwardThread->start();
+
 	// get settings updates
 	connect(_hyperion, &Hyperion::settingsChanged, this, &MessageForwarder::handleSettingsUpdate);
 
@@ -41,6 +47,29 @@ MessageForwarder::~MessageForwarder()
 {
 	while (!_forwardClients.isEmpty())
 		delete _forwardClients.takeFirst();
+
+	// pending deletes are processed when the thread finishes
+	clearJsonConnections();
+	_forwardThread->quit();
+	_forwardThread->wait();
+}
+
+void MessageForwarder::clearJsonConnections()
+{
+	QMutexLocker lock(&_jsonConnectionsMutex);
+	while (!_jsonConnections.isEmpty())
+		_jsonConnections.takeFirst()->deleteLater();
+}
+
+QJsonObject MessageForwarder::getStatistics() const
+{
+	QMutexLocker lock(&_jsonConnectionsMutex);
+	QJsonObject stats;
+	for (const auto* connection : _jsonConnections)
+	{
+		stats[connection->getAddress()] = connection->getStatistics();
+	}
+	return stats;
 }
 
 void MessageForwarder::handleSettingsUpdate(settings::type type, const QJsonDocument &config)
@@ -49,6 +78,7 @@ void MessageForwarder::handleSettingsUpdate(settings::type type, const QJsonDocu
 	{
 		// clear the current targets
 		_jsonSlaves.clear();
+		clearJsonConnections();
 		_flatSlaves.clear();
 		while (!_forwardClients.isEmpty())
 			delete _forwardClients.takeFirst();
@@ -182,7 +212,16 @@ void MessageForwarder::addJsonSlave(const QString& slave)
 	}
 
 	if (_forwarder_enabled && !_jsonSlaves.contains(slave))
+	{
 		_jsonSlaves << slave;
+
+		JsonForwardConnection* connection = new JsonForwardConnection(slave);
+		connection->moveToThread(_forwardThread);
+		QMetaObject::invokeMethod(connection, "connectToHost", Qt::QueuedConnection);
+
+		QMutexLocker lock(&_jsonConnectionsMutex);
+		_jsonConnections << connection;
+	}
 }
 
 void MessageForwarder::addFlatbufferSlave(const QString& slave)
@@ -222,16 +261,11 @@ void MessageForwarder::forwardJsonMessage(const QJsonObject &message)
 {
 	if (_forwarder_enabled)
 	{
-		QTcpSocket client;
-		for (int i=0; i<_jsonSlaves.size(); i++)
+		// only queues the message, the lock is held briefly
+		QMutexLocker lock(&_jsonConnectionsMutex);
+		for (auto* connection : _jsonConnections)
 		{
-			QStringList parts = _jsonSlaves.at(i).split(":");
-			client.connectToHost(QHostAddress(parts[0]), parts[1].toUShort());
-			if ( client.waitForConnected(500) )
-			{
-				sendJsonMessage(message,&client);
-				client.close();
-			}
+			QMetaObject::invokeMethod(connection, "sendMessage", Qt::QueuedConnection, Q_ARG(QJsonObject, message));
 		}
 	}
 }
@@ -244,47 +278,3 @@ void MessageForwarder::forwardFlatbufferMessage(const QString& name, const Image
 			_forwardClients.at(i)->setImage(image);
 	}
 }
-
-void MessageForwarder::sendJsonMessage(const QJsonObject &message, QTcpSocket *socket)
-{
-	// for hyperion classic compatibility
-	QJsonObject jsonMessage = message;
-	if (jsonMessage.contains("tan") && jsonMessage["tan"].isNull())
-		jsonMessage["tan"] = 100;
-
-	// serialize message
-	QJsonDocument writer(jsonMessage);
-	QByteArray serializedMessage = writer.toJson(QJsonDocument::Compact) + "\n";
-
-	// write message
-	socket->write(serializedMessage);
-	if (!socket->waitForBytesWritten())
-	{
-		Debug(_log, "Error while writing data to host");
-		return;
-	}
-
-	// read reply data
-	QByteArray serializedReply;
-	while (!serializedReply.contains('\n'))
-	{
-		// receive reply
-		if (!socket->waitForReadyRead())
-		{
-			Debug(_log, "Error while writing data from host");
-			return;
-		}
-
-		serializedReply += socket->readAll();
-	}
-
-	// parse reply data
-	QJsonParseError error;
-	QJsonDocument reply = QJsonDocument::fromJson(serializedReply ,&error);
-
-	if (error.error != QJsonParseError::NoError)
-	{
-		Error(_log, "Error while parsing reply: invalid json");
-		return;
-	}
-}
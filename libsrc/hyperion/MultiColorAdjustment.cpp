@@ -148,3 +148,66 @@ void MultiColorAdjustment::applyAdjustment(std::vector<ColorRgb>& ledColors)
 		color.blue  = OB + RB + GB + BB + CB + MB + YB + WB;
 	}
 }
+
+void MultiColorAdjustment::applyAdjustment(const std::vector<ColorRgb>& ledColors, std::vector<ColorRgb16>& adjustedColors)
+{
+	// the capacity is kept, no allocation once running
+	adjustedColors.resize(ledColors.size());
+
+	for (size_t i=0; i<ledColors.size(); ++i)
+	{
+		const ColorRgb& color = ledColors[i];
+		ColorRgb16& adjusted = adjustedColors[i];
+
+		ColorAdjustment* adjustment = (i < _ledAdjustments.size()) ? _ledAdjustments[i] : nullptr;
+		if (adjustment == nullptr)
+		{
+			// No transform set for this led (keep the color)
+			adjusted = ColorRgb16::fromRgb(color);
+			continue;
+		}
+
+		uint16_t ored = 0, ogreen = 0, oblue = 0;
+		uint8_t B_RGB = 0, B_CMY = 0, B_W = 0;
+
+		adjustment->_rgbTransform.transform(color.red, color.green, color.blue, ored, ogreen, oblue);
+		adjustment->_rgbTransform.getBrightnessComponents(B_RGB, B_CMY, B_W);
+
+		// 65535^3 needs 48 bit
+		const uint64_t nrng = (uint64_t) (65535-ored)*(65535-ogreen);
+		const uint64_t rng  = (uint64_t) (ored)      *(65535-ogreen);
+		const uint64_t nrg  = (uint64_t) (65535-ored)*(ogreen);
+		const uint64_t rg   = (uint64_t) (ored)      *(ogreen);
+		const uint64_t nb   = 65535-oblue;
+		const uint64_t norm = 65535ULL*65535ULL;
+
+		const uint16_t black   = static_cast<uint16_t>(nrng*nb   /norm);
+		const uint16_t red     = static_cast<uint16_t>(rng *nb   /norm);
+		const uint16_t green   = static_cast<uint16_t>(nrg *nb   /norm);
+		const uint16_t blue    = static_cast<uint16_t>(nrng*oblue/norm);
+		const uint16_t cyan    = static_cast<uint16_t>(nrg *oblue/norm);
+		const uint16_t magenta = static_cast<uint16_t>(rng *oblue/norm);
+		const uint16_t yellow  = static_cast<uint16_t>(rg  *nb   /norm);
+		const uint16_t white   = static_cast<uint16_t>(rg  *oblue/norm);
+
+		uint16_t OR, OG, OB, RR, RG, RB, GR, GG, GB, BR, BG, BB;
+		uint16_t CR, CG, CB, MR, MG, MB, YR, YG, YB, WR, WG, WB;
+
+		adjustment->_rgbBlackAdjustment.apply  (black  , 255  , OR, OG, OB);
+		adjustment->_rgbRedAdjustment.apply    (red    , B_RGB, RR, RG, RB);
+		adjustment->_rgbGreenAdjustment.apply  (green  , B_RGB, GR, GG, GB);
+		adjustment->_rgbBlueAdjustment.apply   (blue   , B_RGB, BR, BG, BB);
+		adjustment->_rgbCyanAdjustment.apply   (cyan   , B_CMY, CR, CG, CB);
+		adjustment->_rgbMagentaAdjustment.apply(magenta, B_CMY, MR, MG, MB);
+		adjustment->_rgbYellowAdjustment.apply (yellow , B_CMY, YR, YG, YB);
+		adjustment->_rgbWhiteAdjustment.apply  (white  , B_W  , WR, WG, WB);
+
+		const uint32_t sumR = (uint32_t) OR + RR + GR + BR + CR + MR + YR + WR;
+		const uint32_t sumG = (uint32_t) OG + RG + GG + BG + CG + MG + YG + WG;
+		const uint32_t sumB = (uint32_t) OB + RB + GB + BB + CB + MB + YB + WB;
+
+		adjusted.red   = static_cast<uint16_t>(qMin(sumR, 65535u));
+		adjusted.green = static_cast<uint16_t>(qMin(sumG, 65535u));
+		adjusted.blue  = static_cast<uint16_t>(qMin(sumB, 65535u));
+	}
+}
@@ -0,0 +1,201 @@
+#include <hyperion/StreamPublisher.h>
+#include <hyperion/Hyperion.h>
+
+#include <QMutexLocker>
+#include <QImage>
+#include <QBuffer>
+#include <QHash>
+#include <QPair>
+#include <QThread>
+
+StreamSubscription::StreamSubscription(Format format, int width, int interval)
+	: QObject()
+	, _format(format)
+	, _width(width)
+	, _interval(interval)
+	, _frameWidth(0)
+	, _frameHeight(0)
+	, _pending(false)
+{
+}
+
+bool StreamSubscription::isDue()
+{
+	return !_lastFrame.isValid() || _lastFrame.elapsed() >= _interval;
+}
+
+void StreamSubscription::offer(const QByteArray& frame, int width, int height)
+{
+	_lastFrame.start();
+	{
+		QMutexLocker lock(&_mutex);
+		_frame = frame;
+		_frameWidth = width;
+		_frameHeight = height;
+	}
+
+	// just one delivery in flight, a slow subscriber gets the latest frame only
+	if (!_pending.exchange(true))
+	{
+		QMetaObject::invokeMethod(this, "deliver", Qt::QueuedConnection);
+	}
+}
+
+void StreamSubscription::deliver()
+{
+	QByteArray frame;
+	int width, height;
+	{
+		QMutexLocker lock(&_mutex);
+		frame = _frame;
+		width = _frameWidth;
+		height = _frameHeight;
+		_pending = false;
+	}
+	emit frameReady(frame, width, height);
+}
+
+StreamPublisher::StreamPublisher(Hyperion* hyperion)
+	: QObject()
+	, _thread(new QThread())
+	, _isEncodePending(false)
+{
+	_thread->setObjectName("StreamPublisher");
+	moveToThread(_thread);
+	_thread->start();
+
+	// just hands over the image, the instance does not wait for the encoding
+	connect(hyperion, &Hyperion::currentImage, this, &StreamPublisher::offerImage, Qt::DirectConnection);
+}
+
+StreamPublisher::~StreamPublisher()
+{
+	_thread->quit();
+	_thread->wait();
+	delete _thread;
+}
+
+QSharedPointer<StreamSubscription> StreamPublisher::subscribe(StreamSubscription::Format format, int width, int interval)
+{
+	// created in the thread of the subscriber, deleted there as well
+	QSharedPointer<StreamSubscription> subscription(new StreamSubscription(format, width, interval), &QObject::deleteLater);
+
+	QMutexLocker lock(&_mutex);
+	_subscriptions.append(subscription.toWeakRef());
+	return subscription;
+}
+
+void StreamPublisher::offerImage(const Image<ColorRgb>& image)
+{
+	{
+		QMutexLocker lock(&_mutex);
+		if (_subscriptions.isEmpty())
+			return;
+
+		// the image data is shared, not copied
+		_latestImage = image;
+	}
+
+	// just one encoding in flight, a newer image replaces the waiting one
+	if (!_isEncodePending.exchange(true))
+	{
+		QMetaObject::invokeMethod(this, "encodeLatestImage", Qt::QueuedConnection);
+	}
+}
+
+void StreamPublisher::encodeLatestImage()
+{
+	Image<ColorRgb> image;
+	QList<QSharedPointer<StreamSubscription>> due;
+	{
+		QMutexLocker lock(&_mutex);
+		image.swap(_latestImage);
+		_isEncodePending = false;
+
+		for (auto it = _subscriptions.begin(); it != _subscriptions.end();)
+		{
+			QSharedPointer<StreamSubscription> subscription = it->toStrongRef();
+			if (subscription.isNull())
+			{
+				it = _subscriptions.erase(it);
+				continue;
+			}
+			if (subscription->isDue())
+			{
+				due.append(subscription);
+			}
+			++it;
+		}
+	}
+
+	if (due.isEmpty() || image.width() == 0 || image.height() == 0)
+		return;
+
+	const int srcWidth = static_cast<int>(image.width());
+	const int srcHeight = static_cast<int>(image.height());
+
+	// downscale and encode every format and width once
+	QHash<int, QByteArray> scaled;
+	QHash<QPair<int, int>, QByteArray> frames;
+	for (const auto& subscription : due)
+	{
+		const int width = (subscription->width() > 0) ? qMin(subscription->width(), srcWidth) : srcWidth;
+		const int height = qMax(1, srcHeight * width / srcWidth);
+
+		const QPair<int, int> key(subscription->format(), width);
+		auto frame = frames.constFind(key);
+		if (frame == frames.constEnd())
+		{
+			auto rgb = scaled.constFind(width);
+			if (rgb == scaled.constEnd())
+			{
+				rgb = scaled.insert(width, downscale(image, width, height));
+			}
+
+			QByteArray encoded;
+			if (subscription->format() == StreamSubscription::RGB)
+			{
+				encoded = rgb.value();
+			}
+			else
+			{
+				QImage jpgImage(reinterpret_cast<const uchar*>(rgb.value().constData()), width, height, 3 * width, QImage::Format_RGB888);
+				QBuffer buffer(&encoded);
+				buffer.open(QIODevice::WriteOnly);
+				jpgImage.save(&buffer, "jpg");
+
+				if (subscription->format() == StreamSubscription::JPG_DATAURL)
+				{
+					encoded = "data:image/jpg;base64," + encoded.toBase64();
+				}
+			}
+			frame = frames.insert(key, encoded);
+		}
+
+		subscription->offer(frame.value(), width, height);
+	}
+}
+
+QByteArray StreamPublisher::downscale(const Image<ColorRgb>& image, int width, int height)
+{
+	const int srcWidth = static_cast<int>(image.width());
+	const int srcHeight = static_cast<int>(image.height());
+
+	if (width == srcWidth && height == srcHeight)
+	{
+		return QByteArray(reinterpret_cast<const char*>(image.memptr()), srcWidth * srcHeight * 3);
+	}
+
+	// nearest neighbour
+	QByteArray rgb(width * height * 3, Qt::Uninitialized);
+	ColorRgb* dst = reinterpret_cast<ColorRgb*>(rgb.data());
+	for (int y = 0; y < height; ++y)
+	{
+		const ColorRgb* srcLine = image.memptr() + (y * srcHeight / height) * srcWidth;
+		for (int x = 0; x < width; ++x)
+		{
+			*dst++ = srcLine[x * srcWidth / width];
+		}
+	}
+	return rgb;
+}
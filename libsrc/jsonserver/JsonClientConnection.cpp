@@ -1,15 +1,28 @@
 // project includes
 #include "JsonClientConnection.h"
 #include <api/JsonAPI.h>
+#include <utils/ServerMetrics.h>
 
 // qt inc
 #include <QTcpSocket>
 #include <QHostAddress>
 
+namespace {
+
+/// Upper limit of a single message, fits a base64 encoded 4k image
+const int MAX_MESSAGE_SIZE = 48 * 1024 * 1024;
+
+/// Handled messages are removed from the receive buffer once they take at least this size
+const int COMPACT_THRESHOLD = 64 * 1024;
+
+}
+
 JsonClientConnection::JsonClientConnection(QTcpSocket *socket, bool localConnection)
 	: QObject()
 	, _socket(socket)
 	, _receiveBuffer()
+	, _readOffset(0)
+	, _scanOffset(0)
 	, _log(Logger::getInstance("JSONCLIENTCONNECTION"))
 {
 	connect(_socket, &QTcpSocket::disconnected, this, &JsonClientConnection::disconnected);
@@ -25,23 +38,61 @@ JsonClientConnection::JsonClientConnection(QTcpSocket *socket, bool localConnect
 
 void JsonClientConnection::readRequest()
 {
-	_receiveBuffer += _socket->readAll();
-	// raw socket data, handling as usual
-	int bytes = _receiveBuffer.indexOf('\n') + 1;
-	while(bytes > 0)
-	{
-		// create message string
-		QString message(QByteArray(_receiveBuffer.data(), bytes));
+	const QByteArray data = _socket->readAll();
+	ServerMetrics::addReceivedBytes(ServerMetrics::JSONSERVER, data.size());
+	_receiveBuffer += data;
 
-		// remove message data from buffer
-		_receiveBuffer = _receiveBuffer.mid(bytes);
+	// handle all complete messages, a client may pipeline several requests in one segment
+	int end;
+	while ((end = _receiveBuffer.indexOf('\n', _scanOffset)) >= 0)
+	{
+		const int size = end - _readOffset;
+		if (size > MAX_MESSAGE_SIZE)
+		{
+			rejectOversizedMessage();
+			return;
+		}
 
-		// handle message
+		// the message refers to the receive buffer, it is parsed before the buffer is modified again
+		const QByteArray message = QByteArray::fromRawData(_receiveBuffer.constData() + _readOffset, size);
+		_readOffset = _scanOffset = end + 1;
 		_jsonAPI->handleMessage(message);
+	}
 
-		// try too look up '\n' again
-		bytes = _receiveBuffer.indexOf('\n') + 1;
+	// the incomplete rest has been searched already
+	_scanOffset = _receiveBuffer.size();
+	if (_scanOffset - _readOffset > MAX_MESSAGE_SIZE)
+	{
+		rejectOversizedMessage();
+		return;
 	}
+
+	// drop handled messages, but do not move a large incomplete message for every segment
+	if (_readOffset == _receiveBuffer.size())
+	{
+		_receiveBuffer.clear();
+		_readOffset = _scanOffset = 0;
+	}
+	else if (_readOffset >= COMPACT_THRESHOLD || _readOffset > _receiveBuffer.size() / 2)
+	{
+		_receiveBuffer.remove(0, _readOffset);
+		_scanOffset -= _readOffset;
+		_readOffset = 0;
+	}
+}
+
+void JsonClientConnection::rejectOversizedMessage()
+{
+	Error(_log, "Message from %s exceeds the maximum size of %d bytes, closing connection", QSTRING_CSTR(_socket->peerAddress().toString()), MAX_MESSAGE_SIZE);
+
+	QJsonObject reply;
+	reply["success"] = false;
+	reply["error"] = "Message exceeds the maximum size";
+	sendMessage(reply);
+
+	_receiveBuffer.clear();
+	_readOffset = _scanOffset = 0;
+	_socket->close();
 }
 
 qint64 JsonClientConnection::sendMessage(QJsonObject message)
@@ -40,6 +40,11 @@ private slots:
 	void disconnected();
 
 private:
+	///
+	/// @brief Reply with an error and close the connection, the stream can not be resynchronized
+	///
+	void rejectOversizedMessage();
+
 	QTcpSocket* _socket;
 	/// new instance of JsonAPI
 	JsonAPI * _jsonAPI;
@@ -47,6 +52,12 @@ private:
 	/// The buffer used for reading data from the socket
 	QByteArray _receiveBuffer;
 
+	/// Start of the first unhandled message in _receiveBuffer
+	int _readOffset;
+
+	/// Position in _receiveBuffer up to which no message delimiter was found
+	int _scanOffset;
+
 	/// The logger instance
 	Logger * _log;
 };
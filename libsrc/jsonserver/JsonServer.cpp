@@ -10,6 +10,7 @@
 #include <bonjour/bonjourserviceregister.h>
 #endif
 #include <utils/NetOrigin.h>
+#include <utils/ServerMetrics.h>
 
 // qt includes
 #include <QTcpServer>
@@ -103,6 +104,7 @@ void JsonServer::newConnection()
 				Debug(_log, "New connection from: %s ",socket->localAddress().toString().toStdString().c_str());
 				JsonClientConnection * connection = new JsonClientConnection(socket, _netOrigin->isLocalAddress(socket->peerAddress(), socket->localAddress()));
 				_openConnections.insert(connection);
+				ServerMetrics::setClients(ServerMetrics::JSONSERVER, _openConnections.size());
 
 				// register slot for cleaning up after the connection closed
 				connect(connection, &JsonClientConnection::connectionClosed, this, &JsonServer::closedConnection);
@@ -118,6 +120,7 @@ void JsonServer::closedConnection()
 	JsonClientConnection* connection = qobject_cast<JsonClientConnection*>(sender());
 	Debug(_log, "Connection closed");
 	_openConnections.remove(connection);
+	ServerMetrics::setClients(ServerMetrics::JSONSERVER, _openConnections.size());
 
 	// schedule to delete the connection object
 	connection->deleteLater();
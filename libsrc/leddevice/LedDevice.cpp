@@ -8,6 +8,7 @@
 #include <QEventLoop>
 #include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
 
 #include "hyperion/Hyperion.h"
 #include <utils/JsonUtils.h>
@@ -30,10 +31,17 @@ LedDevice::LedDevice(const QJsonObject& deviceConfig, QObject* parent)
 	  , _isDeviceReady(false)
 	  , _isDeviceInError(false)
 	  , _isInSwitchOff (false)
+	  , _isRefreshWrite (false)
 	  , _lastWriteTime(QDateTime::currentDateTime())
 	  , _isRefreshEnabled (false)
+	  , _isSkipUnchanged (false)
+	  , _lastWriteDuration_us(0)
+	  , _isFrameSubmitted(false)
+	  , _isFrameSubmitted16(false)
+	  , _metrics(nullptr)
 {
 	_activeDeviceType = deviceConfig["type"].toString("UNSPECIFIED").toLower();
+	_latchTimer.start();
 }
 
 LedDevice::~LedDevice()
@@ -137,6 +145,15 @@ bool LedDevice::init(const QJsonObject &deviceConfig)
 
 	_latchTime_ms =deviceConfig["latchTime"].toInt( _latchTime_ms );
 	_refreshTimerInterval_ms =  deviceConfig["rewriteTime"].toInt( _refreshTimerInterval_ms);
+	_isSkipUnchanged = deviceConfig["skipUnchanged"].toBool(false);
+	if ( deviceConfig["dithering"].toBool(false) && deviceConfig["outputRate"].toDouble(0.0) <= 0.0 )
+	{
+		Warning(_log, "Dithering requires an output rate, the 16 bit colors are rounded to 8 bit instead" );
+	}
+	if ( _isSkipUnchanged )
+	{
+		Debug(_log, "Unchanged LED values are skipped, keep-alive every %dms", _refreshTimerInterval_ms );
+	}
 
 	if ( _refreshTimerInterval_ms > 0 )
 	{
@@ -183,19 +200,11 @@ int LedDevice::updateLeds(const std::vector<ColorRgb>& ledValues)
 	}
 	else
 	{
-		qint64 elapsedTimeMs = _lastWriteTime.msecsTo(QDateTime::currentDateTime());
+		qint64 elapsedTimeMs = _latchTimer.elapsed();
 		if (_latchTime_ms == 0 || elapsedTimeMs >= _latchTime_ms)
 		{
 			//std::cout << "LedDevice::updateLeds(), Elapsed time since last write (" << elapsedTimeMs << ") ms > _latchTime_ms (" << _latchTime_ms << ") ms" << std::endl;
-			retval = write(ledValues);
-			_lastWriteTime = QDateTime::currentDateTime();
-
-			// if device requires refreshing, save Led-Values and restart the timer
-			if ( _isRefreshEnabled && _isEnabled )
-			{
-				this->startRefreshTimer();
-				_lastLedValues = ledValues;
-			}
+			retval = writeFrame(ledValues);
 		}
 		else
 		{
@@ -210,6 +219,101 @@ int LedDevice::updateLeds(const std::vector<ColorRgb>& ledValues)
 	return retval;
 }
 
+void LedDevice::submitFrame(const std::vector<ColorRgb>& ledValues)
+{
+	QMutexLocker lock(&_frameMutex);
+	// assignment reuses the capacity of the buffer, no allocation once running
+	_submittedFrame = ledValues;
+	_isFrameSubmitted = true;
+}
+
+void LedDevice::submitFrame16(const std::vector<ColorRgb16>& ledValues)
+{
+	QMutexLocker lock(&_frameMutex);
+	_submittedFrame16 = ledValues;
+	_isFrameSubmitted16 = true;
+}
+
+bool LedDevice::writeLatestFrame()
+{
+	{
+		QMutexLocker lock(&_frameMutex);
+		if ( _isFrameSubmitted )
+		{
+			_submittedFrame.swap(_outputFrame);
+			_isFrameSubmitted = false;
+			_ditherTarget.clear();
+		}
+		else if ( _isFrameSubmitted16 )
+		{
+			_submittedFrame16.swap(_ditherTarget);
+			_isFrameSubmitted16 = false;
+		}
+		else if ( _ditherTarget.empty() )
+		{
+			return false;
+		}
+	}
+
+	if ( !isEnabled() || !_isDeviceReady || _isDeviceInError )
+	{
+		return false;
+	}
+
+	// dithered values are written in every interval, their average approaches the 16 bit values
+	writeFrame(_ditherTarget.empty() ? _outputFrame : ditherFrame());
+	return true;
+}
+
+int LedDevice::updateLeds16(const std::vector<ColorRgb16>& ledValues)
+{
+	// written on updates and refreshes only, dithering at this irregular rate would flicker or freeze on a fraction
+	return updateLeds(_dither.round(ledValues));
+}
+
+const std::vector<ColorRgb>& LedDevice::ditherFrame()
+{
+	return _dither.dither(_ditherTarget);
+}
+
+int LedDevice::writeFrame(const std::vector<ColorRgb>& ledValues)
+{
+	// unchanged values are not written again, the refresh timer keeps running from the last write as keep-alive
+	if ( _isSkipUnchanged && ledValues == _lastLedValues )
+	{
+		return 0;
+	}
+
+	QElapsedTimer writeTimer;
+	writeTimer.start();
+	const int retval = write(ledValues);
+	const qint64 writeDuration_us = writeTimer.nsecsElapsed() / 1000;
+	_lastWriteDuration_us.store(writeDuration_us, std::memory_order_relaxed);
+	if ( _metrics != nullptr )
+	{
+		_metrics->record(PipelineMetrics::DEVICE_WRITE, writeDuration_us);
+		if ( retval < 0 )
+		{
+			_metrics->increment(PipelineMetrics::DEVICE_WRITE_ERRORS);
+		}
+	}
+	_lastWriteTime = QDateTime::currentDateTime();
+	_latchTimer.restart();
+
+	// if device requires refreshing, save Led-Values and restart the timer, the refresh retries a failed write
+	if ( _isRefreshEnabled && _isEnabled )
+	{
+		this->startRefreshTimer();
+		_lastLedValues = ledValues;
+	}
+	// without refresh a failed write is not saved, so the same values are written again with the next update
+	else if ( _isSkipUnchanged && retval >= 0 )
+	{
+		_lastLedValues = ledValues;
+	}
+	return retval;
+}
+
 int LedDevice::rewriteLEDs()
 {
 	int retval = -1;
@@ -224,8 +328,11 @@ int LedDevice::rewriteLEDs()
 //				printLedValues(_lastLedValues);
 //				//:TESTING:
 
-		retval = write(_lastLedValues);
+		_isRefreshWrite = true;
+		retval = write(_ditherTarget.empty() ? _lastLedValues : ditherFrame());
+		_isRefreshWrite = false;
 		_lastWriteTime = QDateTime::currentDateTime();
+		_latchTimer.restart();
 	}
 	else
 	{
@@ -248,7 +355,9 @@ int LedDevice::writeBlack(int numberOfBlack)
 			QTimer::singleShot(_latchTime_ms, &loop, &QEventLoop::quit);
 			loop.exec();
 		}
+		_isRefreshWrite = true;
 		rc = write(std::vector<ColorRgb>(static_cast<unsigned long>(_ledCount), ColorRgb::BLACK ));
+		_isRefreshWrite = false;
 	}
 	return rc;
 }
@@ -265,6 +374,9 @@ bool LedDevice::switchOn()
 		}
 		else
 		{
+			// the LEDs may show anything after a switch-off, never skip the first values
+			_lastLedValues.clear();
+			_ditherTarget.clear();
 			storeState();
 
 			if ( powerOn() )
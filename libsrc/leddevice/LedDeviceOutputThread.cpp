@@ -0,0 +1,126 @@
+#include "LedDeviceOutputThread.h"
+
+// STL includes
+#include <chrono>
+#include <thread>
+#include <cerrno>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#endif
+
+// Qt includes
+#include <QCoreApplication>
+
+// hyperion includes
+#include <leddevice/LedDevice.h>
+#include <utils/Logger.h>
+#include <utils/PipelineMetrics.h>
+
+namespace {
+
+const int64_t NANOSECONDS_PER_SECOND = 1000000000;
+
+inline int64_t monotonicNow_ns()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline void sleepUntil(int64_t deadline_ns)
+{
+#ifdef __linux__
+	// steady_clock is CLOCK_MONOTONIC, sleep to the absolute deadline to avoid any drift
+	timespec deadline;
+	deadline.tv_sec = static_cast<time_t>(deadline_ns / NANOSECONDS_PER_SECOND);
+	deadline.tv_nsec = static_cast<long>(deadline_ns % NANOSECONDS_PER_SECOND);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR)
+	{
+	}
+#else
+	std::this_thread::sleep_until(std::chrono::steady_clock::time_point(
+		std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(deadline_ns))));
+#endif
+}
+
+}
+
+LedDeviceOutputThread::LedDeviceOutputThread(LedDevice* device, double rate, int priority, int cpu, PipelineMetrics* metrics, QObject* parent)
+	: QThread(parent)
+	, _device(device)
+	, _log(Logger::getInstance("LEDDEVICE"))
+	, _metrics(metrics)
+	, _interval_ns(static_cast<int64_t>(NANOSECONDS_PER_SECOND / rate))
+	, _priority(priority)
+	, _cpu(cpu)
+{
+	setObjectName("LedDeviceOutput");
+}
+
+void LedDeviceOutputThread::applySchedulingPolicy()
+{
+#ifdef __linux__
+	if (_priority > 0)
+	{
+		sched_param param;
+		param.sched_priority = qBound(sched_get_priority_min(SCHED_FIFO), _priority, sched_get_priority_max(SCHED_FIFO));
+		const int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+		if (rc != 0)
+			Warning(_log, "Could not set real-time priority %d for the LED output: %s", param.sched_priority, strerror(rc));
+		else
+			Debug(_log, "LED output runs with real-time priority %d", param.sched_priority);
+	}
+
+	if (_cpu >= 0)
+	{
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(_cpu, &cpuSet);
+		const int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+		if (rc != 0)
+			Warning(_log, "Could not pin the LED output to CPU %d: %s", _cpu, strerror(rc));
+		else
+			Debug(_log, "LED output is pinned to CPU %d", _cpu);
+	}
+#else
+	if (_priority > 0 || _cpu >= 0)
+		Warning(_log, "Real-time priority and CPU pinning of the LED output are only supported on Linux");
+#endif
+}
+
+void LedDeviceOutputThread::run()
+{
+	applySchedulingPolicy();
+
+	// the device was started by QThread::started already, its latch time is known now
+	const int64_t latch_ns = static_cast<int64_t>(_device->getLatchTime()) * 1000000;
+	const int64_t interval_ns = qMax(_interval_ns, latch_ns);
+	Info(_log, "LED output of '%s' runs with %.2f Hz", QSTRING_CSTR(_device->getActiveDeviceType()), static_cast<double>(NANOSECONDS_PER_SECOND) / interval_ns);
+
+	int64_t deadline_ns = monotonicNow_ns() + interval_ns;
+	while (!isInterruptionRequested())
+	{
+		// deliver queued slot calls, timers and socket notifications between the writes
+		QCoreApplication::processEvents(QEventLoop::AllEvents);
+
+		sleepUntil(deadline_ns);
+
+		// drop all slots we missed entirely instead of writing a burst of frames
+		const int64_t writeStart_ns = monotonicNow_ns();
+		const int64_t lateness_ns = writeStart_ns - deadline_ns;
+		if (lateness_ns >= interval_ns)
+		{
+			const int64_t missed = lateness_ns / interval_ns;
+			if (_metrics != nullptr)
+				_metrics->increment(PipelineMetrics::DEVICE_MISSED_DEADLINES, missed);
+			deadline_ns += missed * interval_ns;
+		}
+
+		_device->writeLatestFrame();
+
+		// a late write must not shorten the latch time of the following one
+		deadline_ns = qMax(deadline_ns + interval_ns, writeStart_ns + latch_ns);
+	}
+}
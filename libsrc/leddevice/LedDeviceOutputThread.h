@@ -0,0 +1,60 @@
+#ifndef LEDDEVICEOUTPUTTHREAD_H
+#define LEDDEVICEOUTPUTTHREAD_H
+
+// STL includes
+#include <cstdint>
+
+// Qt includes
+#include <QThread>
+
+class LedDevice;
+class Logger;
+class PipelineMetrics;
+
+///
+/// @brief Thread of a LED-device which writes with a fixed rate instead of on every update
+///
+/// The latest LED values are handed over with LedDevice::submitFrame() and written at precise intervals,
+/// timed by the monotonic clock. The interval is never shorter than the device's latch time.
+/// Writes which could not happen in their interval are dropped and counted as missed deadlines instead of being written in a burst.
+/// Queued slot calls, timers and socket notifications of the device are handled between the writes.
+/// On Linux the thread can run with real-time priority (SCHED_FIFO) and be pinned to a CPU.
+///
+class LedDeviceOutputThread : public QThread
+{
+	Q_OBJECT
+
+public:
+	///
+	/// @brief Constructor
+	/// @param device    The device which is moved to this thread
+	/// @param rate      The output rate in Hz
+	/// @param priority  SCHED_FIFO priority (1-99), 0 keeps the normal scheduling
+	/// @param cpu       The CPU to pin the thread to, negative for no pinning
+	/// @param metrics   The metrics missed deadlines are counted in, may be nullptr
+	/// @param parent    The parent object
+	///
+	LedDeviceOutputThread(LedDevice* device, double rate, int priority, int cpu, PipelineMetrics* metrics, QObject* parent = nullptr);
+
+protected:
+	///
+	/// @brief The output loop, runs until an interruption is requested
+	///
+	void run() override;
+
+private:
+	///
+	/// @brief Apply real-time priority and CPU pinning to the current thread
+	///
+	void applySchedulingPolicy();
+
+	LedDevice* _device;
+	Logger* _log;
+	PipelineMetrics* _metrics;
+
+	int64_t _interval_ns;
+	int _priority;
+	int _cpu;
+};
+
+#endif // LEDDEVICEOUTPUTTHREAD_H
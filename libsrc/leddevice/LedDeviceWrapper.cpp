@@ -6,6 +6,8 @@
 // following file is auto generated by cmake! it contains all available leddevice headers
 #include "LedDevice_headers.h"
 
+#include "LedDeviceOutputThread.h"
+
 // util
 #include <hyperion/Hyperion.h>
 #include <utils/JsonUtils.h>
@@ -48,16 +50,41 @@ void LedDeviceWrapper::createLedDevice(const QJsonObject& config)
 	}
 
 	// create thread and device
-	QThread* thread = new QThread(this);
-	thread->setObjectName("LedDeviceThread");
-	_ledDevice = LedDeviceFactory::construct(config);
+	LedDevice* ledDevice = LedDeviceFactory::construct(config);
+	ledDevice->setMetrics(&_hyperion->getMetrics());
+	{
+		QMutexLocker lock(&_ledDeviceLock);
+		_ledDevice = ledDevice;
+	}
+
+	// with an output rate the device writes the latest values in fixed intervals, otherwise on every update
+	const double outputRate = config["outputRate"].toDouble(0.0);
+	QThread* thread = nullptr;
+	if (outputRate > 0.0)
+	{
+		thread = new LedDeviceOutputThread(_ledDevice, outputRate, config["outputPriority"].toInt(0), config["outputCpu"].toInt(-1), &_hyperion->getMetrics(), this);
+	}
+	else
+	{
+		thread = new QThread(this);
+		thread->setObjectName("LedDeviceThread");
+	}
 	_ledDevice->moveToThread(thread);
 
 	// setup thread management
 	connect(thread, &QThread::started, _ledDevice, &LedDevice::start);
 
 	// further signals
-	connect(this, &LedDeviceWrapper::updateLeds, _ledDevice, &LedDevice::updateLeds, Qt::QueuedConnection);
+	if (outputRate > 0.0)
+	{
+		connect(this, &LedDeviceWrapper::updateLeds, _ledDevice, &LedDevice::submitFrame, Qt::DirectConnection);
+		connect(this, &LedDeviceWrapper::updateLeds16, _ledDevice, &LedDevice::submitFrame16, Qt::DirectConnection);
+	}
+	else
+	{
+		connect(this, &LedDeviceWrapper::updateLeds, _ledDevice, &LedDevice::updateLeds, Qt::QueuedConnection);
+		connect(this, &LedDeviceWrapper::updateLeds16, _ledDevice, &LedDevice::updateLeds16, Qt::QueuedConnection);
+	}
 	connect(this, &LedDeviceWrapper::setEnable, _ledDevice, &LedDevice::setEnable);
 	connect(this, &LedDeviceWrapper::closeLedDevice, _ledDevice, &LedDevice::stop, Qt::BlockingQueuedConnection);
 
@@ -132,6 +159,12 @@ QString LedDeviceWrapper::getActiveDeviceType() const
 	return value;
 }
 
+qint64 LedDeviceWrapper::getLastWriteDuration() const
+{
+	QMutexLocker lock(&_ledDeviceLock);
+	return (_ledDevice != nullptr) ? _ledDevice->getLastWriteDuration() : 0;
+}
+
 QString LedDeviceWrapper::getColorOrder() const
 {
 	QString value;
@@ -180,11 +213,13 @@ void LedDeviceWrapper::stopDeviceThread()
 	// get current thread
 	QThread* oldThread = _ledDevice->thread();
 	disconnect(oldThread, nullptr, nullptr, nullptr);
+	oldThread->requestInterruption();
 	oldThread->quit();
 	oldThread->wait();
 	delete oldThread;
 
 	disconnect(_ledDevice, nullptr, nullptr, nullptr);
+	QMutexLocker lock(&_ledDeviceLock);
 	delete _ledDevice;
 	_ledDevice = nullptr;
 }
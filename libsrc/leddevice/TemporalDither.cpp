@@ -0,0 +1,36 @@
+#include <leddevice/TemporalDither.h>
+
+const std::vector<ColorRgb>& TemporalDither::dither(const std::vector<ColorRgb16>& values)
+{
+	const size_t channelCount = values.size() * 3;
+	if ( _error.size() != channelCount )
+	{
+		_error.assign(channelCount, 0);
+	}
+	_frame.resize(values.size());
+
+	const uint16_t * target = reinterpret_cast<const uint16_t *>(values.data());
+	uint8_t * output = reinterpret_cast<uint8_t *>(_frame.data());
+	for (size_t i = 0; i < channelCount; ++i)
+	{
+		// x * 257 is the 16 bit value of the 8 bit value x, so exact 8 bit values never flicker
+		const uint32_t value = static_cast<uint32_t>(target[i]) + _error[i];
+		output[i] = static_cast<uint8_t>(value / 257);
+		_error[i] = static_cast<uint16_t>(value % 257);
+	}
+	return _frame;
+}
+
+const std::vector<ColorRgb>& TemporalDither::round(const std::vector<ColorRgb16>& values)
+{
+	const size_t channelCount = values.size() * 3;
+	_frame.resize(values.size());
+
+	const uint16_t * target = reinterpret_cast<const uint16_t *>(values.data());
+	uint8_t * output = reinterpret_cast<uint8_t *>(_frame.data());
+	for (size_t i = 0; i < channelCount; ++i)
+	{
+		output[i] = static_cast<uint8_t>((static_cast<uint32_t>(target[i]) + 128) / 257);
+	}
+	return _frame;
+}
@@ -122,6 +122,35 @@ const uint8_t PAYLOAD_PER_LIGHT[] =
 	*/
 };
 
+///
+/// @brief sRGB gamma correction of all 8 bit values
+///
+struct SrgbToLinearTable
+{
+	float values[256];
+
+	SrgbToLinearTable()
+	{
+		for (int i = 0; i < 256; ++i)
+		{
+			const double value = i / 255.0;
+			values[i] = static_cast<float>((value > 0.04045) ? pow((value + 0.055) / (1.0 + 0.055), 2.4) : (value / 12.92));
+		}
+	}
+};
+
+const SrgbToLinearTable& srgbToLinear()
+{
+	static const SrgbToLinearTable table;
+	return table;
+}
+
+inline void putUInt16(char * dest, quint64 value)
+{
+	dest[0] = static_cast<char>((value >> 8) & 0xff);
+	dest[1] = static_cast<char>(value & 0xff);
+}
+
 } //End of constants
 
 bool operator ==(const CiColor& p1, const CiColor& p2)
@@ -184,33 +213,64 @@ CiColor CiColor::rgbToCiColor(double red, double green, double blue, const CiCol
 
 	if(red + green + blue > 0)
 	{
-		// Check if the given XY value is within the color reach of our lamps.
-		if (!isPointInLampsReach(xy, colorSpace))
+		xy = fitIntoLampsReach(xy, colorSpace);
+	}
+	return xy;
+}
+
+CiColor CiColor::rgbToCiColor(const ColorRgb& color, const CiColorTriangle &colorSpace)
+{
+	if (color.red == 0 && color.green == 0 && color.blue == 0)
+	{
+		return { 0.0, 0.0, 0.0 };
+	}
+
+	// Apply gamma correction.
+	const float * linear = srgbToLinear().values;
+	const float r = linear[color.red];
+	const float g = linear[color.green];
+	const float b = linear[color.blue];
+
+	// Convert to XYZ space, the sum is never 0 for a color other than black
+	const float X = r * 0.664511f + g * 0.154324f + b * 0.162028f;
+	const float Y = r * 0.283881f + g * 0.668433f + b * 0.047685f;
+	const float Z = r * 0.000088f + g * 0.072310f + b * 0.986039f;
+	const float sum = X + Y + Z;
+
+	// RGB to HSV/B Conversion after gamma correction V/B for brightness, not Y from XYZ Space.
+	const CiColor xy = { X / sum, Y / sum, std::max(r, std::max(g, b)) };
+
+	return fitIntoLampsReach(xy, colorSpace);
+}
+
+CiColor CiColor::fitIntoLampsReach(CiColor xy, const CiColorTriangle &colorSpace)
+{
+	// Check if the given XY value is within the color reach of our lamps.
+	if (!isPointInLampsReach(xy, colorSpace))
+	{
+		// It seems the color is out of reach let's find the closes color we can produce with our lamp and send this XY value out.
+		XYColor pAB = getClosestPointToPoint(colorSpace.red, colorSpace.green, xy);
+		XYColor pAC = getClosestPointToPoint(colorSpace.blue, colorSpace.red, xy);
+		XYColor pBC = getClosestPointToPoint(colorSpace.green, colorSpace.blue, xy);
+		// Get the distances per point and see which point is closer to our Point.
+		double dAB = getDistanceBetweenTwoPoints(xy, pAB);
+		double dAC = getDistanceBetweenTwoPoints(xy, pAC);
+		double dBC = getDistanceBetweenTwoPoints(xy, pBC);
+		double lowest = dAB;
+		XYColor closestPoint = pAB;
+		if (dAC < lowest)
 		{
-			// It seems the color is out of reach let's find the closes color we can produce with our lamp and send this XY value out.
-			XYColor pAB = getClosestPointToPoint(colorSpace.red, colorSpace.green, xy);
-			XYColor pAC = getClosestPointToPoint(colorSpace.blue, colorSpace.red, xy);
-			XYColor pBC = getClosestPointToPoint(colorSpace.green, colorSpace.blue, xy);
-			// Get the distances per point and see which point is closer to our Point.
-			double dAB = getDistanceBetweenTwoPoints(xy, pAB);
-			double dAC = getDistanceBetweenTwoPoints(xy, pAC);
-			double dBC = getDistanceBetweenTwoPoints(xy, pBC);
-			double lowest = dAB;
-			XYColor closestPoint = pAB;
-			if (dAC < lowest)
-			{
-				lowest = dAC;
-				closestPoint = pAC;
-			}
-			if (dBC < lowest)
-			{
-				//lowest = dBC;
-				closestPoint = pBC;
-			}
-			// Change the xy value to a value which is within the reach of the lamp.
-			xy.x = closestPoint.x;
-			xy.y = closestPoint.y;
+			lowest = dAC;
+			closestPoint = pAC;
 		}
+		if (dBC < lowest)
+		{
+			//lowest = dBC;
+			closestPoint = pBC;
+		}
+		// Change the xy value to a value which is within the reach of the lamp.
+		xy.x = closestPoint.x;
+		xy.y = closestPoint.y;
 	}
 	return xy;
 }
@@ -677,6 +737,9 @@ PhilipsHueLight::PhilipsHueLight(Logger* log, unsigned int id, QJsonObject value
 	  , _transitionTime(0)
 	  , _colorBlack({0.0, 0.0, 0.0})
 	  , _modelId(values[API_MODEID].toString().trimmed().replace("\"", ""))
+	  , _lastRgb(ColorRgb::BLACK)
+	  , _lastCiColor({0.0, 0.0, 0.0})
+	  , _isCiColorCached(false)
 {
 	// Find id in the sets and set the appropriate color space.
 	if (GAMUT_A_MODEL_IDS.find(_modelId) != GAMUT_A_MODEL_IDS.end())
@@ -796,6 +859,17 @@ CiColor PhilipsHueLight::getColor() const
 	return _color;
 }
 
+CiColor PhilipsHueLight::toCiColor(const ColorRgb& color)
+{
+	if ( !_isCiColorCached || color != _lastRgb )
+	{
+		_lastCiColor = CiColor::rgbToCiColor(color, _colorSpace);
+		_lastRgb = color;
+		_isCiColorCached = true;
+	}
+	return _lastCiColor;
+}
+
 CiColorTriangle PhilipsHueLight::getColorSpace() const
 {
 	return _colorSpace;
@@ -1014,6 +1088,7 @@ bool LedDevicePhilipsHue::updateLights(const QMap<quint16, QJsonObject> &map)
 
 	// search user lightid inside map and create light if found
 	_lights.clear();
+	_streamData.clear();
 
 	if(!_lightIds.empty())
 	{
@@ -1245,29 +1320,23 @@ bool LedDevicePhilipsHue::setStreamGroupState(bool state)
 	return false;
 }
 
-QByteArray LedDevicePhilipsHue::prepareStreamData() const
+void LedDevicePhilipsHue::prepareStreamData()
 {
-	QByteArray msg;
-	msg.reserve(static_cast<int>(sizeof(HEADER) + sizeof(PAYLOAD_PER_LIGHT) * _lights.size()));
-	msg.append((const char*)HEADER, sizeof(HEADER));
+	_streamData.clear();
+	_streamData.reserve(static_cast<int>(sizeof(HEADER) + sizeof(PAYLOAD_PER_LIGHT) * _lights.size()));
+	_streamData.append((const char*)HEADER, sizeof(HEADER));
 
 	for (const PhilipsHueLight& light : _lights)
 	{
-		CiColor lightC = light.getColor();
-		quint64 R = lightC.x * 0xffff;
-		quint64 G = lightC.y * 0xffff;
-		quint64 B = lightC.bri * 0xffff;
 		unsigned int id = light.getId();
 		const uint8_t payload[] = {
 			0x00, 0x00, static_cast<uint8_t>(id),
-			static_cast<uint8_t>((R >> 8) & 0xff), static_cast<uint8_t>(R & 0xff),
-			static_cast<uint8_t>((G >> 8) & 0xff), static_cast<uint8_t>(G & 0xff),
-			static_cast<uint8_t>((B >> 8) & 0xff), static_cast<uint8_t>(B & 0xff)
+			0x00, 0x00,
+			0x00, 0x00,
+			0x00, 0x00
 		};
-		msg.append((char*)payload, sizeof(payload));
+		_streamData.append((const char*)payload, sizeof(payload));
 	}
-
-	return msg;
 }
 
 void LedDevicePhilipsHue::stop()
@@ -1405,10 +1474,8 @@ int LedDevicePhilipsHue::writeSingleLights(const std::vector<ColorRgb>& ledValue
 	unsigned int blackCounter = 0;
 	for ( PhilipsHueLight& light : _lights )
 	{
-		// Get color.
-		ColorRgb color = ledValues.at(idx);
-		// Scale colors from [0, 255] to [0, 1] and convert to xy space.
-		CiColor xy = CiColor::rgbToCiColor(color.red / 255.0, color.green / 255.0, color.blue / 255.0, light.getColorSpace());
+		// Get color and convert to xy space, unchanged colors are not converted again.
+		CiColor xy = light.toCiColor(ledValues.at(idx));
 
 		if( _useHueEntertainmentAPI )
 		{
@@ -1443,8 +1510,23 @@ int LedDevicePhilipsHue::writeSingleLights(const std::vector<ColorRgb>& ledValue
 
 void LedDevicePhilipsHue::writeStream()
 {
-	QByteArray streamData = prepareStreamData();
-	writeBytes( static_cast<uint>(streamData.size()), reinterpret_cast<unsigned char *>( streamData.data() ) );
+	if ( _streamData.size() != static_cast<int>(sizeof(HEADER) + sizeof(PAYLOAD_PER_LIGHT) * _lights.size()) )
+	{
+		prepareStreamData();
+	}
+
+	// patch the colors of every light, the header and the light ids stay
+	char * payload = _streamData.data() + sizeof(HEADER);
+	for (const PhilipsHueLight& light : _lights)
+	{
+		const CiColor lightC = light.getColor();
+		putUInt16(payload + 3, static_cast<quint64>(lightC.x * 0xffff));
+		putUInt16(payload + 5, static_cast<quint64>(lightC.y * 0xffff));
+		putUInt16(payload + 7, static_cast<quint64>(lightC.bri * 0xffff));
+		payload += sizeof(PAYLOAD_PER_LIGHT);
+	}
+
+	writeBytes( static_cast<uint>(_streamData.size()), reinterpret_cast<const unsigned char *>( _streamData.constData() ) );
 }
 
 void LedDevicePhilipsHue::setOnOffState(PhilipsHueLight& light, bool on)
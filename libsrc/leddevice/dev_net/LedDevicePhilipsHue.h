@@ -62,6 +62,24 @@ struct CiColor
 	///
 	static CiColor rgbToCiColor(double red, double green, double blue, const CiColorTriangle &colorSpace);
 
+	///
+	/// Converts an 8 bit RGB color to the Hue xy color space and brightness.
+	/// Gamma correction is looked up and the color space conversion is calculated in single precision,
+	/// which is exact enough for the 16 bit values streamed to the lights.
+	///
+	/// @param color the RGB color
+	///
+	/// @return color point
+	///
+	static CiColor rgbToCiColor(const ColorRgb& color, const CiColorTriangle &colorSpace);
+
+	///
+	/// @param xy the color point
+	///
+	/// @return the color point, moved to the closest point the lamp can produce if out of its reach
+	///
+	static CiColor fitIntoLampsReach(CiColor xy, const CiColorTriangle &colorSpace);
+
 	///
 	/// @param p the color point to check
 	///
@@ -148,6 +166,15 @@ public:
 	int getTransitionTime() const;
 	CiColor getColor() const;
 
+	///
+	/// @brief Convert the RGB color to the color space of the light, the last conversion is reused for an unchanged color
+	///
+	/// @param color the RGB color
+	///
+	/// @return color point
+	///
+	CiColor toCiColor(const ColorRgb& color);
+
 	///
 	/// @return the color space of the light determined by the model id reported by the bridge.
 	CiColorTriangle getColorSpace() const;
@@ -172,6 +199,11 @@ private:
 	QString _lightname;
 	CiColorTriangle _colorSpace;
 
+	/// The last converted RGB color and its color point
+	ColorRgb _lastRgb;
+	CiColor _lastCiColor;
+	bool _isCiColorCached;
+
 	/// The json string of the original state.
 	QJsonObject _originalStateJSON;
 
@@ -515,7 +547,10 @@ private:
 
 	void stopBlackTimeoutTimer();
 
-	QByteArray prepareStreamData() const;
+	///
+	/// @brief Build the stream message with the header and the light ids once, writeStream() only patches the colors
+	///
+	void prepareStreamData();
 
 	///
 	bool _switchOffOnBlack;
@@ -533,6 +568,9 @@ private:
 	/// Array to save the lamps.
 	std::vector<PhilipsHueLight> _lights;
 
+	/// The stream message, rebuilt if the lights changed
+	QByteArray _streamData;
+
 	unsigned int _lightsCount;
 	quint16 _groupId;
 
@@ -32,6 +32,9 @@ bool LedDeviceUdpArtNet::init(const QJsonObject &deviceConfig)
 	{
 		_artnet_universe = deviceConfig["universe"].toInt(1);
 		_artnet_channelsPerFixture = deviceConfig["channelsPerFixture"].toInt(3);
+		_artnet_sync = deviceConfig["artSync"].toBool(false);
+
+		preparePackets();
 
 		isInitOK = true;
 	}
@@ -59,10 +62,52 @@ void LedDeviceUdpArtNet::prepare(unsigned this_universe, unsigned this_sequence,
 	artnet_packet.Length	= htons(this_dmxChannelCount);
 }
 
+void LedDeviceUdpArtNet::preparePackets()
+{
+	// walk the channel layout once to get the number of channels and the LED data of every universe
+	std::vector<int> channelCounts;
+	_artnet_rawOffsets.assign(1, 0);
+	int dmxIdx = 0;
+	for (unsigned int ledIdx = 0; ledIdx < _ledRGBCount; ledIdx++)
+	{
+		dmxIdx++;
+		if ( (ledIdx % 3 == 2) && (ledIdx > 0) )
+		{
+			dmxIdx += (_artnet_channelsPerFixture-3);
+		}
+
+		if ( (ledIdx == _ledRGBCount-1) || (dmxIdx >= DMX_MAX) )
+		{
+			channelCounts.push_back(qMin(dmxIdx, DMX_MAX));
+			_artnet_rawOffsets.push_back(static_cast<int>(ledIdx) + 1);
+			dmxIdx = 0;
+		}
+	}
+	_artnet_universeCount = static_cast<int>(channelCounts.size());
+
+	_artnet_packets.clear();
+	for (int universe = 0; universe < _artnet_universeCount; ++universe)
+	{
+		memset(artnet_packet.raw, 0, sizeof(artnet_packet.raw));
+		prepare(_artnet_universe + universe, 0, channelCounts[universe]);
+
+		// the length is rounded up to be even, send the padding too
+		_artnet_packets.emplace_back(reinterpret_cast<const char *>(artnet_packet.raw), ARTNET_DATA + ntohs(artnet_packet.Length));
+	}
+
+	if (_artnet_sync)
+	{
+		// ArtSync: ID, OpCode OpSync, ProtVer, Aux1, Aux2
+		QByteArray syncPacket(ARTSYNC_SIZE, '\0');
+		memcpy(syncPacket.data(), "Art-Net\0", 8);
+		syncPacket[9] = 0x52;
+		syncPacket[11] = 0x0e;
+		_artnet_packets.push_back(syncPacket);
+	}
+}
+
 int LedDeviceUdpArtNet::write(const std::vector<ColorRgb> &ledValues)
 {
-	int retVal            = 0;
-	int thisUniverse	= _artnet_universe;
 	const uint8_t * rawdata = reinterpret_cast<const uint8_t *>(ledValues.data());
 
 /*
@@ -74,30 +119,51 @@ The Sequence field is set to 0x00 to disable this feature.
 		_artnet_seq = 1;
 	}
 
+	// the prebuilt packets keep the unused channels of a fixture at zero
+	int universe = 0;
 	int dmxIdx = 0;			// offset into the current dmx packet
+	uint8_t * data = reinterpret_cast<uint8_t *>(_artnet_packets[universe].data());
+	data[ARTNET_SEQ] = _artnet_seq;
 
-	memset(artnet_packet.raw, 0, sizeof(artnet_packet.raw));
 	for (unsigned int ledIdx = 0; ledIdx < _ledRGBCount; ledIdx++)
 	{
-
-		artnet_packet.Data[dmxIdx++] = rawdata[ledIdx];
+		data[ARTNET_DATA + dmxIdx++] = rawdata[ledIdx];
 		if ( (ledIdx % 3 == 2) && (ledIdx > 0) )
 		{
 			dmxIdx += (_artnet_channelsPerFixture-3);
 		}
 
-//     is this the   last byte of last packet   ||   last byte of other packets
-		if ( (ledIdx == _ledRGBCount-1) || (dmxIdx >= DMX_MAX) )
+//     is this the last byte of other packets
+		if ( (dmxIdx >= DMX_MAX) && (ledIdx < _ledRGBCount-1) )
 		{
-			prepare(thisUniverse, _artnet_seq, dmxIdx);
-			retVal &= writeBytes(18 + qMin(dmxIdx, DMX_MAX), artnet_packet.raw);
-
-			memset(artnet_packet.raw, 0, sizeof(artnet_packet.raw));
-			thisUniverse ++;
+			data = reinterpret_cast<uint8_t *>(_artnet_packets[++universe].data());
+			data[ARTNET_SEQ] = _artnet_seq;
 			dmxIdx = 0;
 		}
+	}
 
+	for (int thisUniverse = 0; thisUniverse < _artnet_universeCount; ++thisUniverse)
+	{
+		const int offset = _artnet_rawOffsets[thisUniverse];
+		if ( isRangeDue(rawdata, offset, _artnet_rawOffsets[thisUniverse + 1] - offset) )
+		{
+			_artnet_sendPackets.push_back(_artnet_packets[thisUniverse]);
+		}
 	}
 
+	int retVal = 0;
+	if ( !_artnet_sendPackets.empty() )
+	{
+		if (_artnet_sync)
+		{
+			_artnet_sendPackets.push_back(_artnet_packets.back());
+		}
+
+		retVal = writeDatagrams(_artnet_sendPackets);
+		setWrittenData(rawdata, _ledRGBCount);
+
+		// drop the shared references, patching the packets must not detach them
+		_artnet_sendPackets.clear();
+	}
 	return retVal;
 }
@@ -37,6 +37,10 @@ typedef union
 
 } artnet_packet_t;
 
+const unsigned int ARTNET_SEQ = 12;
+const unsigned int ARTNET_DATA = 18;
+const unsigned int ARTSYNC_SIZE = 14;
+
 ///
 /// Implementation of the LedDevice interface for sending LED colors to an Art-Net LED-device via UDP
 ///
@@ -82,7 +86,22 @@ private:
 	///
 	void prepare(unsigned this_universe, unsigned this_sequence, unsigned this_dmxChannelCount);
 
+	///
+	/// @brief Build the packets of all universes and the ArtSync packet once,
+	/// write() only patches the sequence numbers and the channel data
+	///
+	void preparePackets();
+
 	artnet_packet_t artnet_packet;
+	/// Prebuilt packets per universe, followed by the ArtSync packet if enabled
+	std::vector<QByteArray> _artnet_packets;
+	/// Packets to be sent with the current frame, all or only the changed universes
+	std::vector<QByteArray> _artnet_sendPackets;
+	/// Offsets of the LED data of every universe, followed by the total size
+	std::vector<int> _artnet_rawOffsets;
+	int _artnet_universeCount = 0;
+	/// Send an ArtSync packet after all universes of a frame, so they are output simultaneously
+	bool _artnet_sync = false;
 	uint8_t _artnet_seq = 1;
 	int _artnet_channelsPerFixture = 3;
 	int _artnet_universe = 1;
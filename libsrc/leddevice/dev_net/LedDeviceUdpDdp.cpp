@@ -0,0 +1,151 @@
+// STL includes
+#include <cstring>
+
+// Qt includes
+#include <QDateTime>
+
+// hyperion local includes
+#include "LedDeviceUdpDdp.h"
+
+const ushort DDP_DEFAULT_PORT = 4048;
+
+/* DDP header, see http://www.3waylabs.com/ddp/ */
+const uint8_t DDP_FLAGS_VER1 = 0x40;
+const uint8_t DDP_FLAGS_TIMECODE = 0x10;
+const uint8_t DDP_FLAGS_PUSH = 0x01;
+const uint8_t DDP_TYPE_RGB24 = 0x0B;	// RGB, 8 bit per element
+const uint8_t DDP_ID_DISPLAY = 0x01;	// default output device
+
+const int DDP_HEADER_SIZE = 10;
+const int DDP_TIMECODE_SIZE = 4;
+const int DDP_SEQ = 1;
+const int DDP_TIMECODE = 10;
+// 480 RGB pixels per packet fit into a standard ethernet frame
+const int DDP_MAX_DATA = 1440;
+
+// offset of the NTP epoch (1900) to the unix epoch (1970) in seconds
+const uint64_t NTP_UNIX_OFFSET = 2208988800ULL;
+
+namespace {
+
+inline void putUInt32(char * dest, uint32_t value)
+{
+	dest[0] = static_cast<char>((value >> 24) & 0xFF);
+	dest[1] = static_cast<char>((value >> 16) & 0xFF);
+	dest[2] = static_cast<char>((value >> 8) & 0xFF);
+	dest[3] = static_cast<char>(value & 0xFF);
+}
+
+}
+
+LedDeviceUdpDdp::LedDeviceUdpDdp(const QJsonObject &deviceConfig)
+	: ProviderUdp(deviceConfig)
+{
+}
+
+LedDevice* LedDeviceUdpDdp::construct(const QJsonObject &deviceConfig)
+{
+	return new LedDeviceUdpDdp(deviceConfig);
+}
+
+bool LedDeviceUdpDdp::init(const QJsonObject &deviceConfig)
+{
+	bool isInitOK = false;
+
+	_port = DDP_DEFAULT_PORT;
+
+	// Initialise sub-class
+	if ( ProviderUdp::init(deviceConfig) )
+	{
+		_ddp_timecode = deviceConfig["timecode"].toBool(false);
+		_ddp_headerSize = DDP_HEADER_SIZE + (_ddp_timecode ? DDP_TIMECODE_SIZE : 0);
+
+		preparePackets();
+
+		isInitOK = true;
+	}
+	return isInitOK;
+}
+
+void LedDeviceUdpDdp::preparePackets()
+{
+	const int dataSize = static_cast<int>(_ledRGBCount);
+
+	_ddp_packets.clear();
+	for (int offset = 0; offset < dataSize; offset += DDP_MAX_DATA)
+	{
+		const int length = qMin(dataSize - offset, DDP_MAX_DATA);
+		const bool isLast = offset + length >= dataSize;
+
+		QByteArray packet(_ddp_headerSize + length, '\0');
+		char * header = packet.data();
+		header[0] = static_cast<char>(DDP_FLAGS_VER1 | (_ddp_timecode ? DDP_FLAGS_TIMECODE : 0) | (isLast ? DDP_FLAGS_PUSH : 0));
+		header[2] = static_cast<char>(DDP_TYPE_RGB24);
+		header[3] = static_cast<char>(DDP_ID_DISPLAY);
+		putUInt32(header + 4, static_cast<uint32_t>(offset));
+		header[8] = static_cast<char>((length >> 8) & 0xFF);
+		header[9] = static_cast<char>(length & 0xFF);
+
+		_ddp_packets.push_back(packet);
+	}
+
+	Debug(_log, "%d LEDs are sent in %d DDP packet(s)", static_cast<int>(_ledCount), static_cast<int>(_ddp_packets.size()));
+}
+
+uint32_t LedDeviceUdpDdp::timecode()
+{
+	const qint64 msecs = QDateTime::currentMSecsSinceEpoch();
+	const uint64_t seconds = static_cast<uint64_t>(msecs / 1000) + NTP_UNIX_OFFSET;
+	const uint32_t fraction = static_cast<uint32_t>((msecs % 1000) * 65536 / 1000);
+	return static_cast<uint32_t>((seconds & 0xFFFF) << 16) | fraction;
+}
+
+int LedDeviceUdpDdp::write(const std::vector<ColorRgb> &ledValues)
+{
+	const uint8_t * rawdata = reinterpret_cast<const uint8_t *>(ledValues.data());
+	const int packetCount = static_cast<int>(_ddp_packets.size());
+
+	// the receiver shows the frame with the last packet sent, even if later ranges did not change
+	int lastPacket = packetCount - 1;
+	while ( lastPacket >= 0 && !isRangeDue(rawdata, lastPacket * DDP_MAX_DATA, _ddp_packets[lastPacket].size() - _ddp_headerSize) )
+	{
+		--lastPacket;
+	}
+
+	if ( lastPacket < 0 )
+	{
+		return 0;
+	}
+
+	// the sequence number cycles through 1-15, 0 means not used
+	_ddp_seq = (_ddp_seq % 15) + 1;
+	const uint32_t frameTimecode = _ddp_timecode ? timecode() : 0;
+	const uint8_t flags = DDP_FLAGS_VER1 | (_ddp_timecode ? DDP_FLAGS_TIMECODE : 0);
+
+	for (int index = 0; index <= lastPacket; ++index)
+	{
+		QByteArray &packet = _ddp_packets[index];
+		const int offset = index * DDP_MAX_DATA;
+		const int length = packet.size() - _ddp_headerSize;
+		if ( index == lastPacket || isRangeDue(rawdata, offset, length) )
+		{
+			char * data = packet.data();
+			data[0] = static_cast<char>(flags | (index == lastPacket ? DDP_FLAGS_PUSH : 0));
+			data[DDP_SEQ] = static_cast<char>(_ddp_seq);
+			if (_ddp_timecode)
+			{
+				putUInt32(data + DDP_TIMECODE, frameTimecode);
+			}
+			memcpy(data + _ddp_headerSize, rawdata + offset, length);
+			_ddp_sendPackets.push_back(packet);
+		}
+	}
+
+	const int retVal = writeDatagrams(_ddp_sendPackets);
+	setWrittenData(rawdata, static_cast<int>(_ledRGBCount));
+
+	// drop the shared references, patching the packets must not detach them
+	_ddp_sendPackets.clear();
+
+	return retVal;
+}
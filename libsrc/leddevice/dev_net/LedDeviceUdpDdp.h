@@ -0,0 +1,75 @@
+#ifndef LEDEVICEUDPDDP_H
+#define LEDEVICEUDPDDP_H
+
+// hyperion includes
+#include "ProviderUdp.h"
+
+///
+/// Implementation of the LedDevice interface for sending LED colors via UDP/DDP (Distributed Display Protocol)
+///
+/// http://www.3waylabs.com/ddp/
+///
+/// Frames larger than a single packet are split at pixel boundaries, every packet carries its data offset.
+/// Only the last packet of a frame has the push flag set, so the receiver displays the frame as a whole.
+///
+class LedDeviceUdpDdp : public ProviderUdp
+{
+public:
+
+	///
+	/// @brief Constructs a DDP LED-device fed via UDP
+	///
+	/// @param deviceConfig Device's configuration as JSON-Object
+	///
+	explicit LedDeviceUdpDdp(const QJsonObject &deviceConfig);
+
+	///
+	/// @brief Constructs the LED-device
+	///
+	/// @param[in] deviceConfig Device's configuration as JSON-Object
+	/// @return LedDevice constructed
+	///
+	static LedDevice* construct(const QJsonObject &deviceConfig);
+
+private:
+
+	///
+	/// @brief Initialise the device's configuration
+	///
+	/// @param[in] deviceConfig the JSON device configuration
+	/// @return True, if success
+	///
+	bool init(const QJsonObject &deviceConfig) override;
+
+	///
+	/// @brief Writes the RGB-Color values to the LEDs.
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @return Zero on success, else negative
+	///
+	int write(const std::vector<ColorRgb> & ledValues) override;
+
+	///
+	/// @brief Build the headers of all packets of a frame once,
+	/// write() only patches the sequence number, the timecode and the pixel data
+	///
+	void preparePackets();
+
+	///
+	/// @brief Current time as DDP timecode (middle 32 bits of an NTP timestamp)
+	///
+	static uint32_t timecode();
+
+	/// Prebuilt packets of a frame
+	std::vector<QByteArray> _ddp_packets;
+	/// Packets to be sent with the current frame, all or only the changed ranges
+	std::vector<QByteArray> _ddp_sendPackets;
+	/// Size of the header, including the timecode if enabled
+	int _ddp_headerSize = 10;
+	/// Sequence number 1-15, 0 is not used
+	uint8_t _ddp_seq = 0;
+	/// Add the time the frame was sent to every packet
+	bool _ddp_timecode = false;
+};
+
+#endif // LEDEVICEUDPDDP_H
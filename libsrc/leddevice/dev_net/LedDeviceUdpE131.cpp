@@ -13,10 +13,10 @@ const ushort E131_DEFAULT_PORT = 5568;
 
 /* defined parameters from http://tsp.esta.org/tsp/documents/docs/BSR_E1-31-20xx_CP-2014-1009r2.pdf */
 const uint32_t VECTOR_ROOT_E131_DATA = 0x00000004;
-//#define VECTOR_ROOT_E131_EXTENDED               0x00000008
+const uint32_t VECTOR_ROOT_E131_EXTENDED = 0x00000008;
 const uint8_t VECTOR_DMP_SET_PROPERTY = 0x02;
 const uint32_t VECTOR_E131_DATA_PACKET = 0x00000002;
-//#define VECTOR_E131_EXTENDED_SYNCHRONIZATION    0x00000001
+const uint32_t VECTOR_E131_EXTENDED_SYNCHRONIZATION = 0x00000001;
 //#define VECTOR_E131_EXTENDED_DISCOVERY          0x00000002
 //#define VECTOR_UNIVERSE_DISCOVERY_UNIVERSE_LIST 0x00000001
 //#define E131_E131_UNIVERSE_DISCOVERY_INTERVAL   10         // seconds
@@ -44,6 +44,7 @@ bool LedDeviceUdpE131::init(const QJsonObject &deviceConfig)
 	if ( ProviderUdp::init(deviceConfig) )
 	{
 		_e131_universe = deviceConfig["universe"].toInt(1);
+		_e131_sync_universe = deviceConfig["syncUniverse"].toInt(0);
 		_e131_source_name = deviceConfig["source-name"].toString("hyperion on "+QHostInfo::localHostName());
 		QString _json_cid = deviceConfig["cid"].toString("");
 
@@ -66,6 +67,11 @@ bool LedDeviceUdpE131::init(const QJsonObject &deviceConfig)
 				this->setInError("CID configured is not a valid UUID. Format expected is \"xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx\"");
 			}
 		}
+
+		if (isInitOK)
+		{
+			preparePackets();
+		}
 	}
 	return isInitOK;
 }
@@ -88,7 +94,7 @@ void LedDeviceUdpE131::prepare(unsigned this_universe, unsigned this_dmxChannelC
 	e131_packet.frame_vector = htonl(VECTOR_E131_DATA_PACKET);
 	snprintf (e131_packet.source_name, sizeof(e131_packet.source_name), "%s", QSTRING_CSTR(_e131_source_name) );
 	e131_packet.priority = 100;
-	e131_packet.reserved = htons(0);
+	e131_packet.sync_address = htons(_e131_sync_universe);
 	e131_packet.options = 0;	// Bit 7 =  Preview_Data
 					// Bit 6 =  Stream_Terminated
 					// Bit 5 = Force_Synchronization
@@ -105,43 +111,80 @@ void LedDeviceUdpE131::prepare(unsigned this_universe, unsigned this_dmxChannelC
 	e131_packet.property_values[0] = 0;	// start code
 }
 
+void LedDeviceUdpE131::preparePackets()
+{
+	const int dmxChannelCount = _ledRGBCount;
+	_e131_universeCount = (dmxChannelCount + DMX_MAX - 1) / DMX_MAX;
+
+	_e131_packets.clear();
+	for (int universe = 0; universe < _e131_universeCount; ++universe)
+	{
+		const int thisChannelCount = qMin(dmxChannelCount - universe * DMX_MAX, DMX_MAX);
+		prepare(_e131_universe + universe, thisChannelCount);
+		_e131_packets.emplace_back(reinterpret_cast<const char *>(e131_packet.raw), E131_DMP_DATA + 1 + thisChannelCount);
+	}
+
+	if (_e131_sync_universe > 0)
+	{
+		e131_sync_packet_t sync_packet;
+		memset(sync_packet.raw, 0, sizeof(sync_packet.raw));
+
+		/* Root Layer */
+		sync_packet.preamble_size = htons(16);
+		sync_packet.postamble_size = 0;
+		memcpy (sync_packet.acn_id, _acn_id, 12);
+		sync_packet.root_flength = htons(0x7000 | (sizeof(sync_packet.raw) - 16));
+		sync_packet.root_vector = htonl(VECTOR_ROOT_E131_EXTENDED);
+		memcpy (sync_packet.cid, _e131_cid.toRfc4122().constData() , sizeof(sync_packet.cid) );
+
+		/* Synchronization Frame Layer */
+		sync_packet.frame_flength = htons(0x7000 | (sizeof(sync_packet.raw) - 38));
+		sync_packet.frame_vector = htonl(VECTOR_E131_EXTENDED_SYNCHRONIZATION);
+		sync_packet.sync_address = htons(_e131_sync_universe);
+		sync_packet.reserved = 0;
+
+		_e131_packets.emplace_back(reinterpret_cast<const char *>(sync_packet.raw), sizeof(sync_packet.raw));
+		Debug(_log, "Universes %d - %d are synchronized via universe %d", _e131_universe, _e131_universe + _e131_universeCount - 1, _e131_sync_universe);
+	}
+}
+
 int LedDeviceUdpE131::write(const std::vector<ColorRgb> &ledValues)
 {
-	int retVal            = 0;
-	int thisChannelCount = 0;
-	int dmxChannelCount  = _ledRGBCount;
+	const int dmxChannelCount = _ledRGBCount;
 	const uint8_t * rawdata = reinterpret_cast<const uint8_t *>(ledValues.data());
 
 	_e131_seq++;
 
-	for (int rawIdx = 0; rawIdx < dmxChannelCount; rawIdx++)
+	// only the sequence number and the channel data change from frame to frame
+	for (int universe = 0; universe < _e131_universeCount; ++universe)
 	{
-		if (rawIdx % DMX_MAX == 0) // start of new packet
+		const int offset = universe * DMX_MAX;
+		const int thisChannelCount = qMin(dmxChannelCount - offset, DMX_MAX);
+		if ( !isRangeDue(rawdata, offset, thisChannelCount) )
 		{
-			thisChannelCount = (dmxChannelCount - rawIdx < DMX_MAX) ? dmxChannelCount % DMX_MAX : DMX_MAX;
-//			                       is this the last packet?         ?       ^^ last packet      : ^^ earlier packets
-
-			prepare(_e131_universe + rawIdx / DMX_MAX, thisChannelCount);
-			e131_packet.sequence_number = _e131_seq;
+			continue;
 		}
 
-		e131_packet.property_values[1 + rawIdx%DMX_MAX] = rawdata[rawIdx];
+		char * packet = _e131_packets[universe].data();
+		packet[E131_FRAME_SEQ] = static_cast<char>(_e131_seq);
+		memcpy(packet + E131_DMP_DATA + 1, rawdata + offset, thisChannelCount);
+		_e131_sendPackets.push_back(_e131_packets[universe]);
+	}
 
-//     is this the      last byte of last packet    ||   last byte of other packets
-		if ( (rawIdx == dmxChannelCount-1) || (rawIdx %DMX_MAX == DMX_MAX-1) )
+	int retVal = 0;
+	if ( !_e131_sendPackets.empty() )
+	{
+		if (_e131_sync_universe > 0)
 		{
-#undef e131debug
-#if e131debug
-			Debug (_log, "send packet: rawidx %d dmxchannelcount %d universe: %d, packetsz %d"
-				, rawIdx
-				, dmxChannelCount
-				, _e131_universe + rawIdx / DMX_MAX
-				, E131_DMP_DATA + 1 + thisChannelCount
-				);
-#endif
-			retVal &= writeBytes(E131_DMP_DATA + 1 + thisChannelCount, e131_packet.raw);
+			_e131_packets.back().data()[E131_SYNC_SEQ] = static_cast<char>(_e131_seq);
+			_e131_sendPackets.push_back(_e131_packets.back());
 		}
-	}
 
+		retVal = writeDatagrams(_e131_sendPackets);
+		setWrittenData(rawdata, dmxChannelCount);
+
+		// drop the shared references, patching the packets must not detach them
+		_e131_sendPackets.clear();
+	}
 	return retVal;
 }
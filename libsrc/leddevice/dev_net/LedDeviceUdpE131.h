@@ -43,6 +43,8 @@
 //#define E131_DMP_ADDR_INC 121
 //#define E131_DMP_COUNT 123
 const unsigned int E131_DMP_DATA=125;
+const unsigned int E131_FRAME_SEQ=111;
+const unsigned int E131_SYNC_SEQ=44;
 
 /* E1.31 Packet Structure */
 typedef union
@@ -63,7 +65,7 @@ typedef union
 		uint32_t frame_vector;
 		char     source_name[64];
 		uint8_t  priority;
-		uint16_t reserved;
+		uint16_t sync_address;
 		uint8_t  sequence_number;
 		uint8_t  options;
 		uint16_t universe;
@@ -82,6 +84,32 @@ typedef union
 	uint8_t raw[638];
 } e131_packet_t;
 
+/* E1.31 Synchronization Packet Structure */
+typedef union
+{
+#pragma pack(push, 1)
+	struct
+	{
+		/* Root Layer */
+		uint16_t preamble_size;
+		uint16_t postamble_size;
+		uint8_t  acn_id[12];
+		uint16_t root_flength;
+		uint32_t root_vector;
+		char     cid[16];
+
+		/* Synchronization Frame Layer */
+		uint16_t frame_flength;
+		uint32_t frame_vector;
+		uint8_t  sequence_number;
+		uint16_t sync_address;
+		uint16_t reserved;
+	};
+#pragma pack(pop)
+
+	uint8_t raw[49];
+} e131_sync_packet_t;
+
 ///
 /// Implementation of the LedDevice interface for sending led colors via udp/E1.31 packets
 ///
@@ -127,7 +155,20 @@ private:
 	///
 	void prepare(unsigned this_universe, unsigned this_dmxChannelCount);
 
+	///
+	/// @brief Build the packets of all universes and the synchronization packet once,
+	/// write() only patches the sequence numbers and the channel data
+	///
+	void preparePackets();
+
 	e131_packet_t e131_packet;
+	/// Prebuilt packets per universe, followed by the synchronization packet if enabled
+	std::vector<QByteArray> _e131_packets;
+	/// Packets to be sent with the current frame, all or only the changed universes
+	std::vector<QByteArray> _e131_sendPackets;
+	int _e131_universeCount = 0;
+	/// Universe to synchronize the data universes with, 0 disables synchronization
+	int _e131_sync_universe = 0;
 	uint8_t _e131_seq = 0;
 	uint8_t _e131_universe = 1;
 	uint8_t _acn_id[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00 };
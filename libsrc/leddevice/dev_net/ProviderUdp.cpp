@@ -4,10 +4,16 @@
 #include <cstdio>
 #include <iostream>
 #include <exception>
+#include <cerrno>
 // Linux includes
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
 
 #include <QStringList>
+#include <QTimer>
 #include <QUdpSocket>
 #include <QHostInfo>
 
@@ -16,11 +22,16 @@
 
 const ushort MAX_PORT = 65535;
 
+// E1.31 receivers drop a source after 2.5s without data, unchanged ranges are sent again after this time
+const int DELTA_KEEPALIVE_MS = 1000;
+
 ProviderUdp::ProviderUdp(const QJsonObject &deviceConfig)
 	: LedDevice(deviceConfig)
+	  , _isDeltaOutput(false)
 	  , _udpSocket (nullptr)
 	  , _port(1)
 	  , _defaultHost("127.0.0.1")
+	  , _keepAliveTimer(nullptr)
 {
 	_latchTime_ms = 1;
 }
@@ -38,6 +49,7 @@ bool ProviderUdp::init(const QJsonObject &deviceConfig)
 	if ( LedDevice::init(deviceConfig) )
 	{
 		QString host = deviceConfig["host"].toString(_defaultHost);
+		_isDeltaOutput = deviceConfig["deltaOutput"].toBool(false);
 
 		if (_address.setAddress(host) )
 		{
@@ -75,6 +87,15 @@ bool ProviderUdp::init(const QJsonObject &deviceConfig)
 
 				_udpSocket = new QUdpSocket(this);
 
+				if ( _isDeltaOutput && _keepAliveTimer == nullptr )
+				{
+					// checks twice per interval, a stale range is sent at the latest 1.5 intervals after its last send
+					_keepAliveTimer = new QTimer(this);
+					_keepAliveTimer->setInterval(DELTA_KEEPALIVE_MS / 2);
+					connect(_keepAliveTimer, &QTimer::timeout, this, [this]() { writeKeepAlive(); });
+					_keepAliveClock.start();
+				}
+
 				isInitOK = true;
 			}
 		}
@@ -103,6 +124,11 @@ int ProviderUdp::open()
 		// Everything is OK, device is ready
 		_isDeviceReady = true;
 		retval = 0;
+
+		if ( _keepAliveTimer != nullptr )
+		{
+			_keepAliveTimer->start();
+		}
 	}
 	else
 	{
@@ -116,6 +142,14 @@ int ProviderUdp::close()
 	int retval = 0;
 	_isDeviceReady = false;
 
+	// the receiver may show anything after a reopen, send everything with the next write
+	_writtenData.clear();
+	_rangeSentTime_ms.clear();
+	if ( _keepAliveTimer != nullptr )
+	{
+		_keepAliveTimer->stop();
+	}
+
 	if ( _udpSocket != nullptr )
 	{
 		// Test, if device requires closing
@@ -138,3 +172,97 @@ int ProviderUdp::writeBytes(const unsigned size, const uint8_t * data)
 
 	return retVal;
 }
+
+int ProviderUdp::writeDatagrams(const std::vector<QByteArray> &datagrams)
+{
+	int retVal = 0;
+
+#ifdef __linux__
+	const qintptr socketDescriptor = _udpSocket->socketDescriptor();
+	if (socketDescriptor >= 0 && _address.protocol() == QAbstractSocket::IPv4Protocol)
+	{
+		sockaddr_in target;
+		memset(&target, 0, sizeof(target));
+		target.sin_family = AF_INET;
+		target.sin_port = htons(_port);
+		target.sin_addr.s_addr = htonl(_address.toIPv4Address());
+
+		std::vector<iovec> iovecs(datagrams.size());
+		std::vector<mmsghdr> messages(datagrams.size());
+		for (size_t i = 0; i < datagrams.size(); ++i)
+		{
+			iovecs[i].iov_base = const_cast<char *>(datagrams[i].constData());
+			iovecs[i].iov_len = static_cast<size_t>(datagrams[i].size());
+
+			memset(&messages[i], 0, sizeof(mmsghdr));
+			messages[i].msg_hdr.msg_name = &target;
+			messages[i].msg_hdr.msg_namelen = sizeof(target);
+			messages[i].msg_hdr.msg_iov = &iovecs[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		// the kernel may accept only a part of the batch, continue with the remaining datagrams
+		size_t sent = 0;
+		while (sent < messages.size())
+		{
+			const int count = sendmmsg(static_cast<int>(socketDescriptor), &messages[sent], static_cast<unsigned int>(messages.size() - sent), 0);
+			if (count <= 0)
+			{
+				Warning(_log, "(%s:%u) Write Error: %s", QSTRING_CSTR(_address.toString()), _port, strerror(errno));
+				return -1;
+			}
+			sent += static_cast<size_t>(count);
+		}
+		return retVal;
+	}
+#endif
+
+	for (const auto &datagram : datagrams)
+	{
+		if (writeBytes(static_cast<unsigned>(datagram.size()), reinterpret_cast<const uint8_t *>(datagram.constData())) < 0)
+			retVal = -1;
+	}
+	return retVal;
+}
+
+bool ProviderUdp::isRangeDue(const uint8_t *data, int offset, int length)
+{
+	if ( !_isDeltaOutput )
+	{
+		return true;
+	}
+
+	const qint64 now_ms = _keepAliveClock.elapsed();
+	const auto sentTime = _rangeSentTime_ms.constFind(offset);
+	const bool isDue = _isRefreshWrite
+		|| _writtenData.size() < static_cast<size_t>(offset + length)
+		|| sentTime == _rangeSentTime_ms.constEnd()
+		|| now_ms - sentTime.value() >= DELTA_KEEPALIVE_MS
+		|| memcmp(_writtenData.data() + offset, data + offset, static_cast<size_t>(length)) != 0;
+
+	if ( isDue )
+	{
+		_rangeSentTime_ms.insert(offset, now_ms);
+	}
+	return isDue;
+}
+
+void ProviderUdp::setWrittenData(const uint8_t *data, int size)
+{
+	if ( _isDeltaOutput )
+	{
+		_writtenData.assign(data, data + size);
+	}
+}
+
+void ProviderUdp::writeKeepAlive()
+{
+	if ( !_isDeviceReady || !_isEnabled || _isDeviceInError || _writtenData.size() < static_cast<size_t>(_ledRGBCount) )
+	{
+		return;
+	}
+
+	std::vector<ColorRgb> ledValues(static_cast<size_t>(_ledCount));
+	memcpy(ledValues.data(), _writtenData.data(), static_cast<size_t>(_ledRGBCount));
+	write(ledValues);
+}
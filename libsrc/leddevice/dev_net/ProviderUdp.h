@@ -1,6 +1,9 @@
 #ifndef PROVIDERUDP_H
 #define PROVIDERUDP_H
 
+// STL includes
+#include <vector>
+
 // LedDevice includes
 #include <leddevice/LedDevice.h>
 
@@ -8,9 +11,13 @@
 #include <utils/Logger.h>
 
 // Qt includes
+#include <QElapsedTimer>
+#include <QHash>
 #include <QHostAddress>
 #include <QUdpSocket>
 
+class QTimer;
+
 ///
 /// The ProviderUdp implements an abstract base-class for LedDevices using UDP packets.
 ///
@@ -63,11 +70,59 @@ protected:
 	///
 	int writeBytes(const unsigned size, const uint8_t *data);
 
+	///
+	/// @brief Writes a sequence of datagrams to the UDP-device, e.g. all universes of a frame.
+	/// On Linux all datagrams are submitted with a single sendmmsg() system call.
+	///
+	/// @param[in] datagrams The datagrams in sending order
+	///
+	/// @return Zero on success, else negative
+	///
+	int writeDatagrams(const std::vector<QByteArray> &datagrams);
+
+	///
+	/// @brief Check, if a range of the LED data has to be sent.
+	/// With delta output only ranges which changed since the last write or were not sent within the keep-alive interval
+	/// are sent, refreshes are always sent completely. A range reported as due is taken as sent.
+	///
+	/// @param[in] data   The LED data to be written
+	/// @param[in] offset Offset of the range in bytes
+	/// @param[in] length Length of the range in bytes
+	///
+	/// @return True, if the range has to be sent
+	///
+	bool isRangeDue(const uint8_t *data, int offset, int length);
+
+	///
+	/// @brief Remember the LED data written for the delta output
+	///
+	/// @param[in] data The LED data written
+	/// @param[in] size The size of the LED data in bytes
+	///
+	void setWrittenData(const uint8_t *data, int size);
+
+	/// Send only universes/ranges which changed since the last write
+	bool _isDeltaOutput;
+
 	///
 	QUdpSocket * _udpSocket;
 	QHostAddress _address;
 	quint16       _port;
 	QString      _defaultHost;
+
+private:
+	///
+	/// @brief Write the last LED data again, with delta output only the ranges not sent within the keep-alive interval are sent
+	///
+	void writeKeepAlive();
+
+	/// LED data of the last write, reference of the delta output
+	std::vector<uint8_t> _writtenData;
+	/// Time a range was sent last by its offset, receivers drop a source not sending for a while
+	QHash<int, qint64> _rangeSentTime_ms;
+	QElapsedTimer _keepAliveClock;
+	/// Sends unchanged ranges with delta output, independent of new frames and the refresh timer
+	QTimer * _keepAliveTimer;
 };
 
 #endif // PROVIDERUDP_H
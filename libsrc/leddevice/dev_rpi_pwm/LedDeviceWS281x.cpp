@@ -33,6 +33,13 @@ bool LedDeviceWS281x::init(const QJsonObject &deviceConfig)
 		}
 		else
 		{
+			_whiteLedColor = ColorRgb::WHITE;
+			const QJsonArray whiteLedColor = deviceConfig["whiteLedColor"].toArray();
+			if (whiteLedColor.size() == 3)
+			{
+				_whiteLedColor = { static_cast<uint8_t>(whiteLedColor[0].toInt()), static_cast<uint8_t>(whiteLedColor[1].toInt()), static_cast<uint8_t>(whiteLedColor[2].toInt()) };
+			}
+
 			_channel = deviceConfig["pwmchannel"].toInt(0);
 			if (_channel != 0 && _channel != 1)
 			{
@@ -109,27 +116,19 @@ int LedDeviceWS281x::close()
 // Send new values down the LED chain
 int LedDeviceWS281x::write(const std::vector<ColorRgb> &ledValues)
 {
+	// RGB strips do not have a white LED
+	RGBW::Rgb_to_Rgbw(ledValues, _rgbwValues, (_led_string.channel[_channel].strip_type == SK6812_STRIP_GRBW) ? _whiteAlgorithm : RGBW::WhiteAlgorithm::WHITE_OFF, _whiteLedColor);
+
 	int idx = 0;
-	for (const ColorRgb& color : ledValues)
+	for (const ColorRgbw& color : _rgbwValues)
 	{
 		if (idx >= _led_string.channel[_channel].count)
 		{
 			break;
 		}
 
-		_temp_rgbw.red = color.red;
-		_temp_rgbw.green = color.green;
-		_temp_rgbw.blue = color.blue;
-		_temp_rgbw.white = 0;
-
-		if (_led_string.channel[_channel].strip_type == SK6812_STRIP_GRBW)
-		{
-			Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
-		}
-
 		_led_string.channel[_channel].leds[idx++] =
-			((uint32_t)_temp_rgbw.white << 24) + ((uint32_t)_temp_rgbw.red << 16) + ((uint32_t)_temp_rgbw.green << 8) + _temp_rgbw.blue;
-
+			((uint32_t)color.white << 24) + ((uint32_t)color.red << 16) + ((uint32_t)color.green << 8) + color.blue;
 	}
 	while (idx < _led_string.channel[_channel].count)
 	{
@@ -66,7 +66,10 @@ private:
 	ws2811_t    _led_string;
 	int         _channel;
 	RGBW::WhiteAlgorithm _whiteAlgorithm;
-	ColorRgbw   _temp_rgbw;
+	ColorRgb    _whiteLedColor;
+
+	/// RGBW colors of the current frame
+	std::vector<ColorRgbw> _rgbwValues;
 };
 
 #endif // LEDEVICEWS281X_H
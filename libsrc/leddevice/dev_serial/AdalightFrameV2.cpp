@@ -0,0 +1,115 @@
+#include "AdalightFrameV2.h"
+
+// STL includes
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+const int MAX_SEGMENT_LEDS = 255;
+const int MIN_RUN_LEDS = 4;			// a shorter run costs more than sending its colors raw
+
+}
+
+size_t AdalightFrameV2::bufferSize(unsigned int ledCount)
+{
+	// plus the trailing checksum
+	return HEADER_SIZE + ledCount * (SEGMENT_HEADER_SIZE + sizeof(ColorRgb)) + 1;
+}
+
+int AdalightFrameV2::encode(uint8_t * frame, const std::vector<ColorRgb> & ledValues, const std::vector<ColorRgb> & controllerValues,
+							int ledCount, bool isKeyFrame)
+{
+	uint8_t * const payload = frame + HEADER_SIZE;
+	uint8_t * dest = payload;
+
+	ledCount = std::min(static_cast<int>(ledValues.size()), ledCount);
+	const int knownCount = static_cast<int>(controllerValues.size());
+	auto isChanged = [&](int idx) { return isKeyFrame || idx >= knownCount || ledValues[idx] != controllerValues[idx]; };
+
+	int idx = 0;
+	while ( idx < ledCount )
+	{
+		if ( !isChanged(idx) )
+		{
+			++idx;
+			continue;
+		}
+
+		// a single unchanged LED within a changed range costs less than starting a new segment
+		int end = idx + 1;
+		while ( end < ledCount && (isChanged(end) || (end + 1 < ledCount && isChanged(end + 1))) )
+		{
+			++end;
+		}
+
+		// runs of identical colors are sent once
+		int rawBegin = idx;
+		int pos = idx;
+		while ( pos < end )
+		{
+			int run = 1;
+			while ( pos + run < end && run < MAX_SEGMENT_LEDS && ledValues[pos + run] == ledValues[pos] )
+			{
+				++run;
+			}
+
+			if ( run >= MIN_RUN_LEDS )
+			{
+				dest = putRawSegments(dest, ledValues, rawBegin, pos);
+
+				*dest++ = static_cast<uint8_t>((pos >> 8) & 0xFF);
+				*dest++ = static_cast<uint8_t>(pos & 0xFF);
+				*dest++ = static_cast<uint8_t>(run);
+				*dest++ = SEGMENT_RUN;
+				memcpy(dest, &ledValues[pos], sizeof(ColorRgb));
+				dest += sizeof(ColorRgb);
+
+				rawBegin = pos + run;
+			}
+			pos += run;
+		}
+		dest = putRawSegments(dest, ledValues, rawBegin, end);
+
+		idx = end;
+	}
+
+	const int payloadSize = static_cast<int>(dest - payload);
+	if ( payloadSize == 0 )
+	{
+		return 0;
+	}
+
+	uint8_t checksum = 0x55;
+	for ( const uint8_t * byte = payload; byte != dest; ++byte )
+	{
+		checksum ^= *byte;
+	}
+	*dest = checksum;
+
+	frame[0] = 'A';
+	frame[1] = 'd';
+	frame[2] = 'b';
+	frame[3] = (payloadSize >> 8) & 0xFF;
+	frame[4] = payloadSize & 0xFF;
+	frame[5] = frame[3] ^ frame[4] ^ 0x55;
+
+	return HEADER_SIZE + payloadSize + 1;
+}
+
+uint8_t * AdalightFrameV2::putRawSegments(uint8_t * dest, const std::vector<ColorRgb> & ledValues, int begin, int end)
+{
+	while ( begin < end )
+	{
+		const int count = std::min(end - begin, MAX_SEGMENT_LEDS);
+		*dest++ = static_cast<uint8_t>((begin >> 8) & 0xFF);
+		*dest++ = static_cast<uint8_t>(begin & 0xFF);
+		*dest++ = static_cast<uint8_t>(count);
+		*dest++ = SEGMENT_RAW;
+		memcpy(dest, &ledValues[begin], count * sizeof(ColorRgb));
+		dest += count * sizeof(ColorRgb);
+
+		begin += count;
+	}
+	return dest;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+// STL includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Utils includes
+#include <utils/ColorRgb.h>
+
+///
+/// @brief Encoder of Adalight protocol v2 ("Adb") frames
+///
+/// A frame only carries the LED ranges changed compared to the controller's colors, runs of identical colors are sent once.
+/// See assets/firmware/arduino/adalight_v2 for the frame format and a reference sketch.
+///
+class AdalightFrameV2
+{
+public:
+	enum
+	{
+		/// 'A' 'd' 'b' <length hi> <length lo> <length checksum>
+		HEADER_SIZE = 6,
+		/// <first led hi> <first led lo> <led count> <mode>
+		SEGMENT_HEADER_SIZE = 4,
+		MAX_PAYLOAD_SIZE = 0xFFFF,
+		/// a complete frame must not exceed the maximum payload
+		MAX_LEDS = 21000,
+		/// the largest frame the controller accepts
+		MAX_FRAME_SIZE = HEADER_SIZE + MAX_PAYLOAD_SIZE + 1
+	};
+
+	enum SegmentMode
+	{
+		/// led count RGB colors follow
+		SEGMENT_RAW = 0,
+		/// one RGB color follows, which is set for all led count LEDs
+		SEGMENT_RUN = 1
+	};
+
+	///
+	/// @brief Size of the buffer required for the largest frame encode() may write, a segment per changed LED
+	///
+	/// @param[in] ledCount Number of LEDs
+	/// @return Size in bytes
+	///
+	static size_t bufferSize(unsigned int ledCount);
+
+	///
+	/// @brief Encode a frame
+	///
+	/// @param[out] frame Buffer of at least bufferSize() bytes
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] controllerValues The colors the controller shows, ignored for a key frame
+	/// @param[in] ledCount Number of LEDs of the device
+	/// @param[in] isKeyFrame Encode all LEDs, not only the changed ones
+	/// @return Size of the frame, zero if nothing changed
+	///
+	static int encode(uint8_t * frame, const std::vector<ColorRgb> & ledValues, const std::vector<ColorRgb> & controllerValues,
+					  int ledCount, bool isKeyFrame);
+
+private:
+	///
+	/// @brief Append raw segments of the given LEDs to a frame
+	///
+	/// @return Pointer behind the segments
+	///
+	static uint8_t * putRawSegments(uint8_t * dest, const std::vector<ColorRgb> & ledValues, int begin, int end);
+};
@@ -1,12 +1,28 @@
 #include "LedDeviceAdalight.h"
+#include "AdalightFrameV2.h"
 
 #include <cassert>
 
+// Constants of protocol v2, see assets/firmware/arduino/adalight_v2
+const char REPLY_SHOWN = 'K';
+const char REPLY_REJECTED = 'N';
+const int KEYFRAME_INTERVAL = 100;	// send a complete frame regularly, should a corrupted one not have been detected
+const int REPLY_TIMEOUT_ms = 500;	// the controller's reply is considered lost
+
 LedDeviceAdalight::LedDeviceAdalight(const QJsonObject &deviceConfig)
 	: ProviderRs232(deviceConfig)
 	  , _headerSize(6)
 	  , _ligthBerryAPA102Mode(false)
+	  , _isProtocolV2(false)
+	  , _isFramePending(false)
+	  , _replyTimer(new QTimer(this))
+	  , _isKeyFrameRequired(true)
+	  , _framesSinceKeyFrame(0)
 {
+	_replyTimer->setSingleShot(true);
+	_replyTimer->setInterval(REPLY_TIMEOUT_ms);
+	connect(_replyTimer, &QTimer::timeout, this, &LedDeviceAdalight::handleReplyTimeout);
+	connect(&_rs232Port, &QSerialPort::readyRead, this, &LedDeviceAdalight::readReplies);
 }
 
 LedDevice* LedDeviceAdalight::construct(const QJsonObject &deviceConfig)
@@ -23,11 +39,25 @@ bool LedDeviceAdalight::init(const QJsonObject &deviceConfig)
 	{
 
 		_ligthBerryAPA102Mode = deviceConfig["lightberry_apa102_mode"].toBool(false);
+		_isProtocolV2 = deviceConfig["protocolV2"].toBool(false);
 
 		// create ledBuffer
 		unsigned int totalLedCount = _ledCount;
 
-		if (_ligthBerryAPA102Mode)
+		if (_isProtocolV2)
+		{
+			if (static_cast<int>(_ledCount) > AdalightFrameV2::MAX_LEDS)
+			{
+				this->setInError(QString("Adalight protocol v2 supports up to %1 LEDs").arg(int(AdalightFrameV2::MAX_LEDS)));
+				return isInitOK;
+			}
+			WarningIf(_ligthBerryAPA102Mode, _log, "LightBerry APA102 mode is ignored with Adalight protocol v2");
+			_ligthBerryAPA102Mode = false;
+
+			_ledBuffer.resize(AdalightFrameV2::bufferSize(_ledCount), 0x00);
+			Debug( _log, "Adalight driver with protocol v2");
+		}
+		else if (_ligthBerryAPA102Mode)
 		{
 			const unsigned int startFrameSize = 4;
 			const unsigned int bytesPerRGBLed = 4;
@@ -47,23 +77,55 @@ bool LedDeviceAdalight::init(const QJsonObject &deviceConfig)
 			_ledBuffer.resize(_headerSize + _ledRGBCount, 0x00);
 		}
 
-		_ledBuffer[0] = 'A';
-		_ledBuffer[1] = 'd';
-		_ledBuffer[2] = 'a';
-		_ledBuffer[3] = (totalLedCount >> 8) & 0xFF; // LED count high byte
-		_ledBuffer[4] = totalLedCount & 0xFF;        // LED count low byte
-		_ledBuffer[5] = _ledBuffer[3] ^ _ledBuffer[4] ^ 0x55; // Checksum
-
-		Debug( _log, "Adalight header for %d leds: %c%c%c 0x%02x 0x%02x 0x%02x", _ledCount,
-			   _ledBuffer[0], _ledBuffer[1], _ledBuffer[2], _ledBuffer[3], _ledBuffer[4], _ledBuffer[5] );
+		// protocol v2 frames carry their payload size in the header, it is written with every frame
+		if (!_isProtocolV2)
+		{
+			_ledBuffer[0] = 'A';
+			_ledBuffer[1] = 'd';
+			_ledBuffer[2] = 'a';
+			_ledBuffer[3] = (totalLedCount >> 8) & 0xFF; // LED count high byte
+			_ledBuffer[4] = totalLedCount & 0xFF;        // LED count low byte
+			_ledBuffer[5] = _ledBuffer[3] ^ _ledBuffer[4] ^ 0x55; // Checksum
+
+			Debug( _log, "Adalight header for %d leds: %c%c%c 0x%02x 0x%02x 0x%02x", _ledCount,
+				   _ledBuffer[0], _ledBuffer[1], _ledBuffer[2], _ledBuffer[3], _ledBuffer[4], _ledBuffer[5] );
+		}
 
 		isInitOK = true;
 	}
 	return isInitOK;
 }
 
+int LedDeviceAdalight::close()
+{
+	_controllerValues.clear();
+	_isFramePending = false;
+	_replyTimer->stop();
+	_isKeyFrameRequired = true;
+
+	return ProviderRs232::close();
+}
+
 int LedDeviceAdalight::write(const std::vector<ColorRgb> & ledValues)
 {
+	if (_isProtocolV2)
+	{
+		// the controller ignores data while updating the LEDs, keep the latest frame until it replied
+		// switching off must write its final frame before the device is closed
+		if ( _replyTimer->isActive() && !_isInSwitchOff )
+		{
+			if ( _isFramePending )
+			{
+				countDroppedFrame();
+			}
+			_pendingValues = ledValues;
+			_isFramePending = true;
+			return 0;
+		}
+		_isFramePending = false;
+		return writeFrameV2(ledValues);
+	}
+
 	if(_ligthBerryAPA102Mode)
 	{
 		for (signed iLed=1; iLed<=static_cast<int>( _ledCount); iLed++)
@@ -85,3 +147,80 @@ int LedDeviceAdalight::write(const std::vector<ColorRgb> & ledValues)
 
 	return rc;
 }
+
+int LedDeviceAdalight::writeFrameV2(const std::vector<ColorRgb> & ledValues)
+{
+	bool isKeyFrame = _isKeyFrameRequired || _isRefreshWrite || _framesSinceKeyFrame >= KEYFRAME_INTERVAL
+							|| _controllerValues.size() != ledValues.size();
+
+	int frameSize = encodeFrameV2(ledValues, isKeyFrame);
+	if ( frameSize > AdalightFrameV2::MAX_FRAME_SIZE )
+	{
+		// scattered changes, the complete frame is smaller
+		isKeyFrame = true;
+		frameSize = encodeFrameV2(ledValues, isKeyFrame);
+	}
+
+	// nothing changed
+	if ( frameSize == 0 )
+	{
+		return 0;
+	}
+
+	int rc = writeBytes(frameSize, _ledBuffer.data());
+	if ( rc >= 0 )
+	{
+		_controllerValues = ledValues;
+		_replyTimer->start();
+		_isKeyFrameRequired = false;
+		_framesSinceKeyFrame = isKeyFrame ? 0 : _framesSinceKeyFrame + 1;
+	}
+	return rc;
+}
+
+int LedDeviceAdalight::encodeFrameV2(const std::vector<ColorRgb> & ledValues, bool isKeyFrame)
+{
+	return AdalightFrameV2::encode(_ledBuffer.data(), ledValues, _controllerValues, static_cast<int>(_ledCount), isKeyFrame);
+}
+
+void LedDeviceAdalight::readReplies()
+{
+	if ( !_isProtocolV2 )
+	{
+		// the sketches' greeting and anything else of the classic protocol is not of interest
+		_rs232Port.readAll();
+		return;
+	}
+
+	for ( const char reply : _rs232Port.readAll() )
+	{
+		if ( reply == REPLY_SHOWN || reply == REPLY_REJECTED )
+		{
+			_replyTimer->stop();
+			if ( reply == REPLY_REJECTED )
+			{
+				Debug( _log, "Frame rejected by the controller, send a complete frame" );
+				_isKeyFrameRequired = true;
+			}
+		}
+	}
+
+	if ( !_replyTimer->isActive() && _isFramePending && _isDeviceReady )
+	{
+		_isFramePending = false;
+		writeFrameV2(_pendingValues);
+	}
+}
+
+void LedDeviceAdalight::handleReplyTimeout()
+{
+	// the controller's colors are unknown, without a new frame the latest colors would not be sent on static input
+	Debug( _log, "No reply from the controller, send a complete frame" );
+	_isKeyFrameRequired = true;
+
+	if ( _isFramePending && _isDeviceReady )
+	{
+		_isFramePending = false;
+		writeFrameV2(_pendingValues);
+	}
+}
@@ -1,12 +1,19 @@
 #ifndef LEDEVICETADALIGHT_H
 #define LEDEVICETADALIGHT_H
 
+// Qt includes
+#include <QTimer>
+
 // hyperion includes
 #include "ProviderRs232.h"
 
 ///
 /// Implementation of the LedDevice interface for writing to an Adalight LED-device.
 ///
+/// Protocol v2 ("Adb" frames) only sends the LED ranges changed since the last frame, runs of identical colors
+/// are sent once. The controller replies to every frame after it is shown, the next frame is not sent before.
+/// See assets/firmware/arduino/adalight_v2 for the frame format and a reference sketch.
+///
 class LedDeviceAdalight : public ProviderRs232
 {
 	Q_OBJECT
@@ -37,6 +44,13 @@ private:
 	///
 	bool init(const QJsonObject &deviceConfig) override;
 
+	///
+	/// @brief Closes the output device, the controller's colors are unknown after reopening.
+	///
+	/// @return Zero on success (i.e. device is closed), else negative
+	///
+	int close() override;
+
 	///
 	/// @brief Writes the RGB-Color values to the LEDs.
 	///
@@ -45,8 +59,56 @@ private:
 	///
 	int write(const std::vector<ColorRgb> & ledValues) override;
 
+	///
+	/// @brief Writes the RGB-Color values as protocol v2 frame, complete or only the changes to the controller's colors
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @return Zero on success, else negative
+	///
+	int writeFrameV2(const std::vector<ColorRgb> & ledValues);
+
+	///
+	/// @brief Encode a protocol v2 frame into the LED buffer, see AdalightFrameV2
+	///
+	/// @param[in] ledValues The RGB-color per LED
+	/// @param[in] isKeyFrame Encode all LEDs, not only the changed ones
+	/// @return Size of the frame, zero if nothing changed
+	///
+	int encodeFrameV2(const std::vector<ColorRgb> & ledValues, bool isKeyFrame);
+
 	const short _headerSize;
 	bool        _ligthBerryAPA102Mode;
+
+	/// Use protocol v2, delta frames with flow control
+	bool _isProtocolV2;
+
+	/// Colors the controller shows, base of the delta frames
+	std::vector<ColorRgb> _controllerValues;
+
+	/// Latest colors not sent yet, as the controller did not reply to the previous frame
+	std::vector<ColorRgb> _pendingValues;
+	bool _isFramePending;
+
+	/// Runs while a frame waits for the controller's reply, the reply is considered lost on timeout
+	QTimer* _replyTimer;
+
+	/// The controller's colors are unknown, send the next frame complete
+	bool _isKeyFrameRequired;
+
+	/// Frames sent since the last complete one
+	int _framesSinceKeyFrame;
+
+private slots:
+
+	///
+	/// @brief Handle the controller's replies, send the pending frame
+	///
+	void readReplies();
+
+	///
+	/// @brief The controller's reply was lost, send the pending frame complete
+	///
+	void handleReplyTimeout();
 };
 
 #endif // LEDEVICETADALIGHT_H
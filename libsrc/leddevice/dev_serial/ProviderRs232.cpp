@@ -6,14 +6,21 @@
 // qt includes
 #include <QSerialPortInfo>
 #include <QEventLoop>
+#include <QTimer>
 
 #include <chrono>
+#include <cstring>
+
+// hyperion includes
+#include <utils/PipelineMetrics.h>
 
 // Constants
 constexpr std::chrono::milliseconds WRITE_TIMEOUT{1000};	// device write timeout in ms
 constexpr std::chrono::milliseconds OPEN_TIMEOUT{5000};		// device open timeout in ms
 const int MAX_WRITE_TIMEOUTS = 5;	// Maximum number of allowed timeouts
 const int NUM_POWEROFF_WRITE_BLACK = 2;	// Number of write "BLACK" during powering off
+const int BITS_PER_SERIAL_BYTE = 10;	// 8N1: start bit, 8 data bits, stop bit
+constexpr std::chrono::seconds STATISTICS_INTERVAL{10};	// interval to report dropped frames of asynchronous writes
 
 ProviderRs232::ProviderRs232(const QJsonObject &deviceConfig)
 	: LedDevice(deviceConfig)
@@ -22,7 +29,20 @@ ProviderRs232::ProviderRs232(const QJsonObject &deviceConfig)
 	  ,_isAutoDeviceName(false)
 	  ,_delayAfterConnect_ms(0)
 	  ,_frameDropCounter(0)
+	  ,_isAsyncWrite(false)
+	  ,_isFramePending(false)
+	  ,_linkIdleTimer(new QTimer(this))
+	  ,_linkBusyUntil_us(0)
+	  ,_writeStalledSince_us(0)
+	  ,_statisticsStart_us(0)
+	  ,_statisticsBytes(0)
+	  ,_statisticsFrames(0)
+	  ,_statisticsDropped(0)
 {
+	_linkIdleTimer->setSingleShot(true);
+	_linkIdleTimer->setTimerType(Qt::PreciseTimer);
+	connect(_linkIdleTimer, &QTimer::timeout, this, &ProviderRs232::writePendingFrame);
+	connect(&_rs232Port, &QSerialPort::bytesWritten, this, &ProviderRs232::onBytesWritten);
 }
 
 bool ProviderRs232::init(const QJsonObject &deviceConfig)
@@ -48,11 +68,13 @@ bool ProviderRs232::init(const QJsonObject &deviceConfig)
 		_isAutoDeviceName     = _deviceName.toLower() == "auto";
 		_baudRate_Hz          = deviceConfig["rate"].toInt();
 		_delayAfterConnect_ms = deviceConfig["delayAfterConnect"].toInt(1500);
+		_isAsyncWrite         = deviceConfig["asyncWrite"].toBool(false);
 
 		Debug(_log, "deviceName   : %s", QSTRING_CSTR(_deviceName));
 		Debug(_log, "AutoDevice   : %d", _isAutoDeviceName);
 		Debug(_log, "baudRate_Hz  : %d", _baudRate_Hz);
 		Debug(_log, "delayAfCon ms: %d", _delayAfterConnect_ms);
+		Debug(_log, "asyncWrite   : %d", _isAsyncWrite);
 
 		isInitOK = true;
 	}
@@ -85,6 +107,12 @@ int ProviderRs232::close()
 
 	_isDeviceReady = false;
 
+	// a pending frame is not written anymore
+	_linkIdleTimer->stop();
+	_isFramePending = false;
+	_linkBusyUntil_us = 0;
+	_writeStalledSince_us = 0;
+
 	// Test, if device requires closing
 	if (_rs232Port.isOpen())
 	{
@@ -135,6 +163,10 @@ bool ProviderRs232::tryOpen(int delayAfterConnect_ms)
 		Info(_log, "Opening UART: %s", QSTRING_CSTR(_deviceName));
 
 		_frameDropCounter = 0;
+		_statisticsStart_us = PipelineMetrics::now_us();
+		_statisticsBytes = 0;
+		_statisticsFrames = 0;
+		_statisticsDropped = 0;
 
 		_rs232Port.setBaudRate( _baudRate_Hz );
 
@@ -208,6 +240,16 @@ int ProviderRs232::writeBytes(const qint64 size, const uint8_t *data)
 
 	DebugIf( _isInSwitchOff, _log, "[%s]", QSTRING_CSTR(uint8_t_to_hex_string(data, size, 32)) );
 
+	// switching off must have written its final frame before the device is closed
+	if ( _isAsyncWrite && !_isInSwitchOff )
+	{
+		return writeAsync(size, data);
+	}
+
+	// the frame written now supersedes the pending one
+	_linkIdleTimer->stop();
+	_isFramePending = false;
+
 	qint64 bytesWritten = _rs232Port.write(reinterpret_cast<const char*>(data), size);
 	if (bytesWritten == -1 || bytesWritten != size)
 	{
@@ -253,6 +295,95 @@ int ProviderRs232::writeBytes(const qint64 size, const uint8_t *data)
 	return rc;
 }
 
+int ProviderRs232::writeAsync(const qint64 size, const uint8_t *data)
+{
+	// a controller which does not take any data fails like a write timeout when writing blocking
+	if ( _writeStalledSince_us > 0 && PipelineMetrics::now_us() - _writeStalledSince_us > std::chrono::duration_cast<std::chrono::microseconds>(WRITE_TIMEOUT).count() )
+	{
+		this->setInError( QString ("Timeout writing data to %1").arg(_deviceName) );
+		return -1;
+	}
+
+	if ( _isFramePending )
+	{
+		++_statisticsDropped;
+		countDroppedFrame();
+	}
+
+	// reuse the buffer of the previous frame
+	_pendingFrame.resize(static_cast<int>(size));
+	memcpy(_pendingFrame.data(), data, static_cast<size_t>(size));
+	_isFramePending = true;
+
+	writePendingFrame();
+
+	return 0;
+}
+
+void ProviderRs232::writePendingFrame()
+{
+	if ( !_isFramePending || !_rs232Port.isOpen() )
+	{
+		return;
+	}
+
+	// the previous frame is not handed to the driver yet, onBytesWritten() retries
+	if ( _rs232Port.bytesToWrite() > 0 )
+	{
+		return;
+	}
+
+	// the driver takes data faster than the link transmits it, keep the frame until the previous one is sent
+	const int64_t now_us = PipelineMetrics::now_us();
+	if ( _linkBusyUntil_us > now_us )
+	{
+		if ( !_linkIdleTimer->isActive() )
+		{
+			_linkIdleTimer->start(static_cast<int>((_linkBusyUntil_us - now_us + 999) / 1000));
+		}
+		return;
+	}
+
+	const qint64 size = _pendingFrame.size();
+	if ( _rs232Port.write(_pendingFrame.constData(), size) != size )
+	{
+		this->setInError( QString ("Rs232 SerialPortError: %1").arg(_rs232Port.errorString()) );
+		return;
+	}
+	_isFramePending = false;
+	_writeStalledSince_us = now_us;
+	_linkBusyUntil_us = now_us + size * BITS_PER_SERIAL_BYTE * 1000000 / qMax(_baudRate_Hz, 1);
+
+	_statisticsBytes += size;
+	++_statisticsFrames;
+	const int64_t elapsed_us = now_us - _statisticsStart_us;
+	if ( elapsed_us >= std::chrono::duration_cast<std::chrono::microseconds>(STATISTICS_INTERVAL).count() )
+	{
+		if ( _statisticsDropped > 0 )
+		{
+			const double utilisation = 100.0 * _statisticsBytes * BITS_PER_SERIAL_BYTE * 1000000 / (static_cast<double>(elapsed_us) * _baudRate_Hz);
+			Info(_log, "%s: %d frames written, %d dropped, %.0f%% of %d baud used", QSTRING_CSTR(_deviceName), _statisticsFrames, _statisticsDropped, utilisation, _baudRate_Hz);
+		}
+		_statisticsStart_us = now_us;
+		_statisticsBytes = 0;
+		_statisticsFrames = 0;
+		_statisticsDropped = 0;
+	}
+}
+
+void ProviderRs232::onBytesWritten(qint64 /*bytes*/)
+{
+	if ( !_isAsyncWrite )
+	{
+		return;
+	}
+
+	// the driver made progress, the controller is still taking data
+	_writeStalledSince_us = (_rs232Port.bytesToWrite() > 0) ? PipelineMetrics::now_us() : 0;
+
+	writePendingFrame();
+}
+
 QString ProviderRs232::discoverFirst()
 {
 	// take first available USB serial port - currently no probing!
@@ -6,6 +6,9 @@
 
 // qt includes
 #include <QSerialPort>
+#include <QByteArray>
+
+class QTimer;
 
 ///
 /// The ProviderRs232 implements an abstract base-class for LedDevices using a RS232-device.
@@ -76,6 +79,10 @@ protected:
 	///
 	/// @brief Write the given bytes to the RS232-device
 	///
+	/// With asynchronous writes the data is queued as the pending frame and written as soon as the link
+	/// has transmitted the previous one. A newer frame replaces a pending one, i.e. frames which cannot be
+	/// transmitted in time at the configured baud rate are dropped instead of stalling the updates.
+	///
 	/// @param[in[ size The length of the data
 	/// @param[in] data The data
 	/// @return Zero on success, else negative
@@ -98,8 +105,31 @@ protected slots:
 	///
 	void setInError( const QString& errorMsg) override;
 
+private slots:
+
+	///
+	/// @brief Write the pending frame, if the serial port and the link are idle (asynchronous writes)
+	///
+	void writePendingFrame();
+
+	///
+	/// @brief Handle the serial port having handed data to the driver (asynchronous writes)
+	///
+	/// @param bytes The number of bytes handed over
+	///
+	void onBytesWritten(qint64 bytes);
+
 private:
 
+	///
+	/// @brief Queue the given bytes as the pending frame
+	///
+	/// @param[in[ size The length of the data
+	/// @param[in] data The data
+	/// @return Zero on success, else negative
+	///
+	int writeAsync(const qint64 size, const uint8_t *data);
+
 	///
 	/// @brief Try to open device if not opened
 	///
@@ -115,6 +145,28 @@ private:
 
 	/// Frames dropped, as write failed
 	int _frameDropCounter;
+
+	/// Write frames without waiting for their transmission?
+	bool _isAsyncWrite;
+
+	/// The latest frame not written yet
+	QByteArray _pendingFrame;
+	bool _isFramePending;
+
+	/// Triggers the pending frame's write when the link is estimated to be idle
+	QTimer* _linkIdleTimer;
+
+	/// Estimated time the link has transmitted all data written, derived from the baud rate
+	int64_t _linkBusyUntil_us;
+
+	/// Time the serial port has been waiting for the driver to take data since, zero if not waiting
+	int64_t _writeStalledSince_us;
+
+	/// Throughput of the link in the current statistics interval
+	int64_t _statisticsStart_us;
+	qint64 _statisticsBytes;
+	int _statisticsFrames;
+	int _statisticsDropped;
 };
 
 #endif // PROVIDERRS232_H
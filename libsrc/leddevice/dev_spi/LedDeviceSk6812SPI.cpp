@@ -3,6 +3,7 @@
 LedDeviceSk6812SPI::LedDeviceSk6812SPI(const QJsonObject &deviceConfig)
 	: ProviderSpi(deviceConfig)
 	  , _whiteAlgorithm(RGBW::WhiteAlgorithm::INVALID)
+	  , _whiteLedColor(ColorRgb::WHITE)
 	  , SPI_BYTES_PER_COLOUR(4)
 	  , bitpair_to_byte {
 		  0b10001000,
@@ -40,10 +41,17 @@ bool LedDeviceSk6812SPI::init(const QJsonObject &deviceConfig)
 		{
 			Debug( _log, "whiteAlgorithm : %s", QSTRING_CSTR(whiteAlgorithm));
 
+			const QJsonArray whiteLedColor = deviceConfig["whiteLedColor"].toArray();
+			if (whiteLedColor.size() == 3)
+			{
+				_whiteLedColor = { static_cast<uint8_t>(whiteLedColor[0].toInt()), static_cast<uint8_t>(whiteLedColor[1].toInt()), static_cast<uint8_t>(whiteLedColor[2].toInt()) };
+			}
+
 			WarningIf(( _baudRate_Hz < 2050000 || _baudRate_Hz > 4000000 ), _log, "SPI rate %d outside recommended range (2050000 -> 4000000)", _baudRate_Hz);
 
 			const int SPI_FRAME_END_LATCH_BYTES = 3;
-			_ledBuffer.resize(_ledRGBWCount * SPI_BYTES_PER_COLOUR + SPI_FRAME_END_LATCH_BYTES, 0x00);
+			setBitPatterns(bitpair_to_byte);
+			_ledBuffer.assign(_ledRGBWCount * SPI_BYTES_PER_COLOUR + SPI_FRAME_END_LATCH_BYTES, idleByte());
 
 			isInitOK = true;
 		}
@@ -53,30 +61,9 @@ bool LedDeviceSk6812SPI::init(const QJsonObject &deviceConfig)
 
 int LedDeviceSk6812SPI::write(const std::vector<ColorRgb> &ledValues)
 {
-	unsigned spi_ptr = 0;
-	const int SPI_BYTES_PER_LED = sizeof(ColorRgbw) * SPI_BYTES_PER_COLOUR;
-
-
-	for (const ColorRgb& color : ledValues)
-	{
-		RGBW::Rgb_to_Rgbw(color, &_temp_rgbw, _whiteAlgorithm);
-		uint32_t colorBits = 
-			((uint32_t)_temp_rgbw.red << 24) +
-			((uint32_t)_temp_rgbw.green << 16) +
-			((uint32_t)_temp_rgbw.blue << 8) +
-			_temp_rgbw.white;
-
-		for (int j=SPI_BYTES_PER_LED - 1; j>=0; j--)
-		{
-			_ledBuffer[spi_ptr+j] = bitpair_to_byte[ colorBits & 0x3 ];
-			colorBits >>= 2;
-		}
-		spi_ptr += SPI_BYTES_PER_LED;
-	}
-
-	_ledBuffer[spi_ptr++] = 0;
-	_ledBuffer[spi_ptr++] = 0;
-	_ledBuffer[spi_ptr++] = 0;
+	RGBW::Rgb_to_Rgbw(ledValues, _rgbwValues, _whiteAlgorithm, _whiteLedColor);
+	encodeBitPatterns(reinterpret_cast<const uint8_t *>(_rgbwValues.data()), static_cast<unsigned>(_rgbwValues.size() * sizeof(ColorRgbw)), _ledBuffer.data());
 
+	// the latch bytes at the end of the buffer stay idle
 	return writeBytes(_ledBuffer.size(), _ledBuffer.data());
 }
@@ -44,11 +44,13 @@ private:
 	int write(const std::vector<ColorRgb> & ledValues) override;
 
 	RGBW::WhiteAlgorithm _whiteAlgorithm;
+	ColorRgb _whiteLedColor;
 
 	const int SPI_BYTES_PER_COLOUR;
 	uint8_t bitpair_to_byte[4];
 
-	ColorRgbw _temp_rgbw;
+	/// RGBW colors of the current frame
+	std::vector<ColorRgbw> _rgbwValues;
 };
 
 #endif // LEDEVICESK6812SPI_H
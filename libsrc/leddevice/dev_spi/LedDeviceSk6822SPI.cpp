@@ -66,7 +66,8 @@ bool LedDeviceSk6822SPI::init(const QJsonObject &deviceConfig)
 	{
 		WarningIf(( _baudRate_Hz < 2000000 || _baudRate_Hz > 2460000 ), _log, "SPI rate %d outside recommended range (2000000 -> 2460000)", _baudRate_Hz);
 
-		_ledBuffer.resize( (_ledRGBCount *  SPI_BYTES_PER_COLOUR) + (_ledCount * SPI_BYTES_WAIT_TIME ) + SPI_FRAME_END_LATCH_BYTES, 0x00);
+		setBitPatterns(bitpair_to_byte);
+		_ledBuffer.assign( (_ledRGBCount *  SPI_BYTES_PER_COLOUR) + (_ledCount * SPI_BYTES_WAIT_TIME ) + SPI_FRAME_END_LATCH_BYTES, idleByte());
 		//	Debug(_log, "_ledBuffer.resize(_ledRGBCount:%d * SPI_BYTES_PER_COLOUR:%d) + ( _ledCount:%d * SPI_BYTES_WAIT_TIME:%d ) + SPI_FRAME_END_LATCH_BYTES:%d, 0x00)", _ledRGBCount, SPI_BYTES_PER_COLOUR, _ledCount, SPI_BYTES_WAIT_TIME,  SPI_FRAME_END_LATCH_BYTES);
 
 		isInitOK = true;
@@ -77,22 +78,12 @@ bool LedDeviceSk6822SPI::init(const QJsonObject &deviceConfig)
 
 int LedDeviceSk6822SPI::write(const std::vector<ColorRgb> &ledValues)
 {
-	unsigned spi_ptr = 0;
-	const int SPI_BYTES_PER_LED = sizeof(ColorRgb) * SPI_BYTES_PER_COLOUR;
+	uint8_t * spi_ptr = _ledBuffer.data();
 
 	for (const ColorRgb& color : ledValues)
 	{
-		uint32_t colorBits = ((unsigned int)color.red << 16)
-							 | ((unsigned int)color.green << 8)
-							 | color.blue;
-
-		for (int j=SPI_BYTES_PER_LED - 1; j>=0; j--)
-		{
-			_ledBuffer[spi_ptr+j] = bitpair_to_byte[ colorBits & 0x3 ];
-			colorBits >>= 2;
-		}
-		spi_ptr += SPI_BYTES_PER_LED;
-		spi_ptr += SPI_BYTES_WAIT_TIME;	// the wait between led time is all zeros
+		spi_ptr = encodeBitPatterns(reinterpret_cast<const uint8_t *>(&color), sizeof(ColorRgb), spi_ptr);
+		spi_ptr += SPI_BYTES_WAIT_TIME;	// the wait between led time stays idle
 	}
 
 /*
@@ -63,7 +63,8 @@ bool LedDeviceWs2812SPI::init(const QJsonObject &deviceConfig)
 	{
 		WarningIf(( _baudRate_Hz < 2106000 || _baudRate_Hz > 3075000 ), _log, "SPI rate %d outside recommended range (2106000 -> 3075000)", _baudRate_Hz);
 
-		_ledBuffer.resize(_ledRGBCount * SPI_BYTES_PER_COLOUR + SPI_FRAME_END_LATCH_BYTES, 0x00);
+		setBitPatterns(bitpair_to_byte);
+		_ledBuffer.assign(_ledRGBCount * SPI_BYTES_PER_COLOUR + SPI_FRAME_END_LATCH_BYTES, idleByte());
 
 		isInitOK = true;
 	}
@@ -73,27 +74,8 @@ bool LedDeviceWs2812SPI::init(const QJsonObject &deviceConfig)
 
 int LedDeviceWs2812SPI::write(const std::vector<ColorRgb> &ledValues)
 {
-	unsigned spi_ptr = 0;
-	const int SPI_BYTES_PER_LED = sizeof(ColorRgb) * SPI_BYTES_PER_COLOUR;
-
-	for (const ColorRgb& color : ledValues)
-	{
-		uint32_t colorBits = ((unsigned int)color.red << 16)
-							 | ((unsigned int)color.green << 8)
-							 | color.blue;
-
-		for (int j=SPI_BYTES_PER_LED - 1; j>=0; j--)
-		{
-			_ledBuffer[spi_ptr+j] = bitpair_to_byte[ colorBits & 0x3 ];
-			colorBits >>= 2;
-		}
-		spi_ptr += SPI_BYTES_PER_LED;
-	}
-
-	for (int j=0; j < SPI_FRAME_END_LATCH_BYTES; j++)
-	{
-		_ledBuffer[spi_ptr++] = 0;
-	}
+	// the latch bytes at the end of the buffer stay idle
+	encodeBitPatterns(reinterpret_cast<const uint8_t *>(ledValues.data()), static_cast<unsigned>(ledValues.size() * sizeof(ColorRgb)), _ledBuffer.data());
 
 	return writeBytes(_ledBuffer.size(), _ledBuffer.data());
 }
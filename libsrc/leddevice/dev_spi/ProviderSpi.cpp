@@ -10,10 +10,35 @@
 #include <unistd.h>
 #include <sys/ioctl.h>
 
+// Qt includes
+#include <QFile>
+
 // Local Hyperion includes
 #include "ProviderSpi.h"
 #include <utils/Logger.h>
 
+namespace {
+
+/// Default buffer size of spidev, one message must not carry more bytes (module parameter "bufsiz")
+const unsigned SPIDEV_DEFAULT_BUFSIZ = 4096;
+
+unsigned spidevBufferSize()
+{
+	QFile file("/sys/module/spidev/parameters/bufsiz");
+	if (file.open(QIODevice::ReadOnly))
+	{
+		bool isOk = false;
+		const unsigned bufsiz = file.readAll().trimmed().toUInt(&isOk);
+		if (isOk && bufsiz > 0)
+		{
+			return bufsiz;
+		}
+	}
+	return SPIDEV_DEFAULT_BUFSIZ;
+}
+
+}
+
 ProviderSpi::ProviderSpi(const QJsonObject &deviceConfig)
 	: LedDevice(deviceConfig)
 	, _deviceName("/dev/spidev0.0")
@@ -21,8 +46,12 @@ ProviderSpi::ProviderSpi(const QJsonObject &deviceConfig)
 	, _fid(-1)
 	, _spiMode(SPI_MODE_0)
 	, _spiDataInvert(false)
+	, _isInversionEncoded(false)
+	, _isTimingEncoded(false)
+	, _maxTransferSize(SPIDEV_DEFAULT_BUFSIZ)
 {
 	memset(&_spi, 0, sizeof(_spi));
+	memset(_bitPatterns, 0, sizeof(_bitPatterns));
 	_latchTime_ms = 1;
 }
 
@@ -85,6 +114,9 @@ int ProviderSpi::open()
 				}
 				else
 				{
+					_maxTransferSize = spidevBufferSize();
+					Debug(_log, "Maximum SPI transfer size: %u bytes", _maxTransferSize);
+
 					// Everything OK -> enable device
 					_isDeviceReady = true;
 					retval = 0;
@@ -124,6 +156,20 @@ int ProviderSpi::close()
 	return retval;
 }
 
+void ProviderSpi::setBitPatterns(const uint8_t bitpairToByte[4])
+{
+	const uint8_t invertMask = _spiDataInvert ? 0xFF : 0x00;
+	for (unsigned value = 0; value < 256; ++value)
+	{
+		for (unsigned i = 0; i < 4; ++i)
+		{
+			_bitPatterns[value][i] = bitpairToByte[(value >> (6 - 2 * i)) & 0x03] ^ invertMask;
+		}
+	}
+	_isInversionEncoded = true;
+	_isTimingEncoded = true;
+}
+
 int ProviderSpi::writeBytes(unsigned size, const uint8_t * data)
 {
 	if (_fid < 0)
@@ -131,19 +177,41 @@ int ProviderSpi::writeBytes(unsigned size, const uint8_t * data)
 		return -1;
 	}
 
-	_spi.tx_buf = __u64(data);
-	_spi.len    = __u32(size);
+	// clockless LEDs latch on the gap between two messages, a split frame would be shown partially
+	if (_isTimingEncoded && size > _maxTransferSize)
+	{
+		this->setInError(QString("The frame of %1 bytes exceeds the SPI buffer of %2 bytes. "
+								 "Raise the buffer with the kernel parameter spidev.bufsiz=%1 (e.g. in /boot/cmdline.txt)")
+						 .arg(size).arg(_maxTransferSize));
+		return -1;
+	}
 
-	if (_spiDataInvert)
+	const uint8_t * txData = data;
+	if (_spiDataInvert && !_isInversionEncoded)
 	{
-		uint8_t * newdata = (uint8_t *)malloc(size);
-		for (unsigned i = 0; i<size; i++) {
-			newdata[i] = data[i] ^ 0xff;
+		if (_txBuffer.size() < size)
+		{
+			_txBuffer.resize(size);
+		}
+		for (unsigned i = 0; i < size; ++i)
+		{
+			_txBuffer[i] = data[i] ^ 0xff;
 		}
-		_spi.tx_buf = __u64(newdata);
+		txData = _txBuffer.data();
 	}
 
-	int retVal = ioctl(_fid, SPI_IOC_MESSAGE(1), &_spi);
+	// spidev limits the size of a message, long strips of clocked LEDs are written with consecutive messages
+	int retVal = 0;
+	unsigned offset = 0;
+	while (offset < size && retVal >= 0)
+	{
+		const unsigned chunkSize = qMin(size - offset, _maxTransferSize);
+		_spi.tx_buf = __u64(txData + offset);
+		_spi.len    = __u32(chunkSize);
+
+		retVal = ioctl(_fid, SPI_IOC_MESSAGE(1), &_spi);
+		offset += chunkSize;
+	}
 	ErrorIf((retVal < 0), _log, "SPI failed to write. errno: %d, %s", errno,  strerror(errno) );
 
 	return retVal;
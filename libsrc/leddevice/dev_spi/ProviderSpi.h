@@ -1,5 +1,9 @@
 #pragma once
 
+// STL includes
+#include <vector>
+#include <cstring>
+
 // Linux-SPI includes
 #include <linux/spi/spidev.h>
 
@@ -47,6 +51,8 @@ protected:
 	///
 	/// Writes the given bytes/bits to the SPI-device and sleeps the latch time to ensure that the
 	/// values are latched.
+	/// Data of clocked LEDs larger than the spidev buffer is written in consecutive messages.
+	/// Clockless LEDs (see setBitPatterns()) take a pause between messages as reset, their data must fit into the buffer.
 	///
 	/// @param[in[ size The length of the data
 	/// @param[in] data The data
@@ -55,6 +61,40 @@ protected:
 	///
 	int writeBytes(unsigned size, const uint8_t *data);
 
+	///
+	/// Prepares the table expanding every data byte into 4 SPI bytes, two data bits per SPI byte (MSB first).
+	/// The inversion of the data pattern is folded into the table, data encoded via encodeBitPatterns()
+	/// is written as is by writeBytes().
+	/// Marks the device as clockless, its bit timing is encoded in the data.
+	///
+	/// @param[in] bitpairToByte The SPI byte for each of the 4 bit pair values
+	///
+	void setBitPatterns(const uint8_t bitpairToByte[4]);
+
+	///
+	/// Expands the given bytes via the bit pattern table
+	///
+	/// @param[in] data The data bytes, e.g. the colors
+	/// @param[in] size The number of data bytes
+	/// @param[out] dest Buffer for 4 * size SPI bytes
+	///
+	/// @return Pointer behind the last SPI byte written
+	///
+	uint8_t * encodeBitPatterns(const uint8_t *data, unsigned size, uint8_t *dest) const
+	{
+		for (unsigned i = 0; i < size; ++i)
+		{
+			memcpy(dest, _bitPatterns[data[i]], 4);
+			dest += 4;
+		}
+		return dest;
+	}
+
+	///
+	/// The SPI byte keeping the data line low, e.g. for latch and wait times (considers the inversion)
+	///
+	uint8_t idleByte() const { return (_spiDataInvert && _isInversionEncoded) ? 0xFF : 0x00; }
+
 	/// The name of the output device
 	QString _deviceName;
 
@@ -72,4 +112,20 @@ protected:
 
 	/// The transfer structure for writing to the spi-device
 	spi_ioc_transfer _spi;
+
+private:
+	/// SPI bytes of every data byte
+	uint8_t _bitPatterns[256][4];
+
+	/// Does the data written already contain the inversion?
+	bool _isInversionEncoded;
+
+	/// The LEDs are clockless, the data must not be split into several messages
+	bool _isTimingEncoded;
+
+	/// Persistent buffer for the inverted data
+	std::vector<uint8_t> _txBuffer;
+
+	/// Maximum number of bytes spidev accepts per message
+	unsigned _maxTransferSize;
 };
@@ -1,5 +1,6 @@
 // project includes
 #include "ProtoClientConnection.h"
+#include <utils/ServerMetrics.h>
 
 // qt
 #include <QTcpSocket>
@@ -30,7 +31,9 @@ ProtoClientConnection::ProtoClientConnection(QTcpSocket* socket, int timeout, QO
 
 void ProtoClientConnection::readyRead()
 {
-	_receiveBuffer += _socket->readAll();
+	const QByteArray data = _socket->readAll();
+	ServerMetrics::addReceivedBytes(ServerMetrics::PROTOSERVER, data.size());
+	_receiveBuffer += data;
 
 	// check if we can read a message size
 	if (_receiveBuffer.size() <= 4)
@@ -4,6 +4,7 @@
 // util
 #include <utils/NetOrigin.h>
 #include <utils/GlobalSignals.h>
+#include <utils/ServerMetrics.h>
 
 // qt
 #include <QJsonObject>
@@ -75,6 +76,7 @@ void ProtoServer::newConnection()
 				connect(client, &ProtoClientConnection::setGlobalInputColor, GlobalSignals::getInstance(), &GlobalSignals::setGlobalColor);
 				connect(GlobalSignals::getInstance(), &GlobalSignals::globalRegRequired, client, &ProtoClientConnection::registationRequired);
 				_openConnections.append(client);
+				ServerMetrics::setClients(ServerMetrics::PROTOSERVER, _openConnections.size());
 			}
 			else
 				socket->close();
@@ -87,6 +89,7 @@ void ProtoServer::clientDisconnected()
 	ProtoClientConnection* client = qobject_cast<ProtoClientConnection*>(sender());
 	client->deleteLater();
 	_openConnections.removeAll(client);
+	ServerMetrics::setClients(ServerMetrics::PROTOSERVER, _openConnections.size());
 }
 
 void ProtoServer::startServer()
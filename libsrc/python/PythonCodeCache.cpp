@@ -0,0 +1,67 @@
+#include <python/PythonCodeCache.h>
+#include <utils/Logger.h>
+
+#include <marshal.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+
+QMutex PythonCodeCache::_mutex;
+QHash<QString, PythonCodeCache::Entry> PythonCodeCache::_entries;
+
+PyObject* PythonCodeCache::load(const QString& script, Logger* log)
+{
+	const QFileInfo info(script);
+	const QDateTime lastModified = info.lastModified();
+	const qint64 size = info.size();
+
+	{
+		QMutexLocker lock(&_mutex);
+		auto it = _entries.constFind(script);
+		if (it != _entries.constEnd() && it->lastModified == lastModified && it->size == size)
+		{
+			const QByteArray bytecode = it->bytecode;
+			lock.unlock();
+			return PyMarshal_ReadObjectFromString(bytecode.constData(), bytecode.size());
+		}
+	}
+
+	QFile file(script);
+	if (!file.open(QIODevice::ReadOnly))
+	{
+		Error(log, "Unable to open script file %s.", QSTRING_CSTR(script));
+		return nullptr;
+	}
+	const QByteArray source = file.readAll();
+	file.close();
+
+	PyObject* code = Py_CompileString(source.constData(), QSTRING_CSTR(script), Py_file_input); // New Reference
+	if (code == nullptr)
+	{
+		return nullptr;
+	}
+
+	PyObject* marshalled = PyMarshal_WriteObjectToString(code, Py_MARSHAL_VERSION); // New Reference
+	if (marshalled != nullptr)
+	{
+		Entry entry { lastModified, size, QByteArray(PyBytes_AS_STRING(marshalled), PyBytes_GET_SIZE(marshalled)) };
+		Py_DECREF(marshalled);
+
+		QMutexLocker lock(&_mutex);
+		_entries.insert(script, entry);
+	}
+	else
+	{
+		// not cacheable, but still executable
+		PyErr_Clear();
+	}
+
+	return code;
+}
+
+void PythonCodeCache::clear()
+{
+	QMutexLocker lock(&_mutex);
+	_entries.clear();
+}
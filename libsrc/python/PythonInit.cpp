@@ -7,6 +7,7 @@
 
 #include <python/PythonInit.h>
 #include <python/PythonUtils.h>
+#include <python/PythonInterpreterPool.h>
 
 // qt include
 #include <QCoreApplication>
@@ -49,6 +50,10 @@ PythonInit::PythonInit()
 	}
 
 	PyEval_InitThreads(); // Create the GIL
+
+	// effects start without the delay of creating a sub-interpreter
+	PythonInterpreterPool::prewarm(1);
+
 	mainThreadState = PyEval_SaveThread();
 }
 
@@ -56,5 +61,6 @@ PythonInit::~PythonInit()
 {
 	Debug(Logger::getInstance("DAEMON"), "Cleaning up Python interpreter");
 	PyEval_RestoreThread(mainThreadState);
+	PythonInterpreterPool::clear();
 	Py_Finalize();
 }
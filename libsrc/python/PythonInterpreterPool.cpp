@@ -0,0 +1,153 @@
+#include <python/PythonInterpreterPool.h>
+
+QMap<PyInterpreterState*, QSet<QString>> PythonInterpreterPool::_baselineModules;
+QMap<PyInterpreterState*, PyThreadState*> PythonInterpreterPool::_keepers;
+QList<PyInterpreterState*> PythonInterpreterPool::_idle;
+
+PyThreadState* PythonInterpreterPool::acquire()
+{
+	if (_idle.isEmpty())
+	{
+		return createInterpreter();
+	}
+
+	PyInterpreterState* interp = _idle.takeLast();
+	PyThreadState* tstate = PyThreadState_New(interp);
+	PyThreadState_Swap(tstate);
+	dropKeeper(interp);
+	resetInterpreter(_baselineModules.value(interp));
+	return tstate;
+}
+
+void PythonInterpreterPool::release(PyThreadState* tstate)
+{
+	PyErr_Clear();
+
+	if (_idle.size() < MAX_IDLE)
+	{
+		park(tstate);
+	}
+	else
+	{
+		_baselineModules.remove(tstate->interp);
+		Py_EndInterpreter(tstate);
+	}
+}
+
+void PythonInterpreterPool::prewarm(int count)
+{
+	PyThreadState* current = PyThreadState_Get();
+	for (int i = 0; i < count && _idle.size() < MAX_IDLE; ++i)
+	{
+		PyThreadState* tstate = createInterpreter();
+		if (tstate == nullptr)
+		{
+			break;
+		}
+		park(tstate);
+	}
+	PyThreadState_Swap(current);
+}
+
+void PythonInterpreterPool::clear()
+{
+	// every interpreter gets a thread state of this thread to end it
+	PyThreadState* current = PyThreadState_Get();
+	for (PyInterpreterState* interp : _idle)
+	{
+		PyThreadState* tstate = PyThreadState_New(interp);
+		PyThreadState_Swap(tstate);
+		dropKeeper(interp);
+		Py_EndInterpreter(tstate);
+	}
+	_idle.clear();
+	_baselineModules.clear();
+	PyThreadState_Swap(current);
+}
+
+PyThreadState* PythonInterpreterPool::createInterpreter()
+{
+	PyThreadState* tstate = Py_NewInterpreter();
+	if (tstate == nullptr)
+	{
+		return nullptr;
+	}
+
+	// modules used by almost every effect
+	for (const char* name : { "hyperion", "time", "colorsys", "math" })
+	{
+		Py_XDECREF(PyImport_ImportModule(name));
+	}
+	PyErr_Clear();
+
+	QSet<QString> baseline;
+	PyObject* names = PyDict_Keys(PyImport_GetModuleDict()); // New Reference
+	for (Py_ssize_t i = 0; names != nullptr && i < PyList_GET_SIZE(names); ++i)
+	{
+		PyObject* name = PyList_GET_ITEM(names, i); // Borrowed reference
+		if (PyUnicode_Check(name))
+		{
+			baseline.insert(QString(PyUnicode_AsUTF8(name)));
+		}
+	}
+	Py_XDECREF(names);
+	_baselineModules.insert(tstate->interp, baseline);
+
+	return tstate;
+}
+
+void PythonInterpreterPool::park(PyThreadState* tstate)
+{
+	PyInterpreterState* interp = tstate->interp;
+
+	// the next user attaches its own thread state, the keeper is never made current
+	_keepers.insert(interp, PyThreadState_New(interp));
+	PyThreadState_Clear(tstate);
+	PyThreadState_Swap(nullptr);
+	PyThreadState_Delete(tstate);
+
+	_idle.append(interp);
+}
+
+void PythonInterpreterPool::dropKeeper(PyInterpreterState* interp)
+{
+	PyThreadState* keeper = _keepers.take(interp);
+	PyThreadState_Clear(keeper);
+	PyThreadState_Delete(keeper);
+}
+
+void PythonInterpreterPool::resetInterpreter(const QSet<QString>& baseline)
+{
+	PyErr_Clear();
+
+	// drop the modules imported by the previous effect, __main__ and hyperion hold its state
+	PyObject* modules = PyImport_GetModuleDict(); // Borrowed reference
+	PyObject* names = PyDict_Keys(modules); // New Reference
+	for (Py_ssize_t i = 0; names != nullptr && i < PyList_GET_SIZE(names); ++i)
+	{
+		PyObject* name = PyList_GET_ITEM(names, i); // Borrowed reference
+		if (!PyUnicode_Check(name))
+		{
+			continue;
+		}
+
+		const QString moduleName(PyUnicode_AsUTF8(name));
+		if (!baseline.contains(moduleName) || moduleName == "__main__" || moduleName == "hyperion")
+		{
+			PyDict_DelItem(modules, name);
+		}
+	}
+	Py_XDECREF(names);
+
+	// a new __main__ module with an empty namespace
+	PyObject* main_module = PyImport_AddModule("__main__"); // Borrowed reference
+	if (main_module != nullptr)
+	{
+		PyObject* main_dict = PyModule_GetDict(main_module); // Borrowed reference
+		PyDict_SetItemString(main_dict, "__builtins__", PyEval_GetBuiltins());
+	}
+
+	// a new hyperion module without the attributes set for the previous effect
+	Py_XDECREF(PyImport_ImportModule("hyperion"));
+	PyErr_Clear();
+}
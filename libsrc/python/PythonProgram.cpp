@@ -1,5 +1,7 @@
 #include <python/PythonProgram.h>
 #include <python/PythonUtils.h>
+#include <python/PythonCodeCache.h>
+#include <python/PythonInterpreterPool.h>
 #include <utils/Logger.h>
 
 #include <QThread>
@@ -13,15 +15,13 @@ PythonProgram::PythonProgram(const QString & name, Logger * log) :
 	// get global lock
 	PyEval_RestoreThread(mainThreadState);
 
-	// Initialize a new thread state
-	_tstate = Py_NewInterpreter();
+	// Get a warm interpreter from the pool with a new thread state of this thread
+	_tstate = PythonInterpreterPool::acquire();
 	if(_tstate == nullptr)
 	{
 		PyEval_ReleaseLock();
 		Error(_log, "Failed to get thread state for %s",QSTRING_CSTR(_name));
-		return;
 	}
-	PyThreadState_Swap(_tstate);
 }
 
 PythonProgram::~PythonProgram()
@@ -50,8 +50,8 @@ PythonProgram::~PythonProgram()
 		s = PyInterpreterState_ThreadHead(_tstate->interp);
 	}
 
-	// Clean up the thread state
-	Py_EndInterpreter(_tstate);
+	// Clean up the thread state and return the interpreter to the pool
+	PythonInterpreterPool::release(_tstate);
 	PyEval_ReleaseLock();
 }
 
@@ -68,94 +68,140 @@ void PythonProgram::execute(const QByteArray & python_code)
 
 	if (!result)
 	{
-		if (PyErr_Occurred()) // Nothing needs to be done for a borrowed reference
-		{
-			Error(_log,"###### PYTHON EXCEPTION ######");
-			Error(_log,"## In effect '%s'", QSTRING_CSTR(_name));
-			/* Objects all initialized to NULL for Py_XDECREF */
-			PyObject *errorType = NULL, *errorValue = NULL, *errorTraceback = NULL;
+		handleError();
+	}
+	else
+	{
+		Py_DECREF(result);  // release "result" when done
+	}
 
-			PyErr_Fetch(&errorType, &errorValue, &errorTraceback); // New Reference or NULL
-			PyErr_NormalizeException(&errorType, &errorValue, &errorTraceback);
+	Py_DECREF(main_dict);  // release "main_dict" when done
+}
 
-			// Extract exception message from "errorValue"
-			if(errorValue)
-			{
-				QString message;
-				if(PyObject_HasAttrString(errorValue, "__class__"))
-				{
-					PyObject *classPtr = PyObject_GetAttrString(errorValue, "__class__"); // New Reference
-					PyObject *class_name = NULL; /* Object "class_name" initialized to NULL for Py_XDECREF */
-					class_name = PyObject_GetAttrString(classPtr, "__name__"); // New Reference or NULL
+bool PythonProgram::executeScript(const QString & script)
+{
+	if (!_tstate)
+		return false;
 
-					if(class_name && PyUnicode_Check(class_name))
-						message.append(PyUnicode_AsUTF8(class_name));
+	PyObject *code = PythonCodeCache::load(script, _log); // New Reference or NULL
+	if (!code)
+	{
+		if (!PyErr_Occurred())
+			return false;
 
-					Py_DECREF(classPtr); // release "classPtr" when done
-					Py_XDECREF(class_name); // Use Py_XDECREF() to ignore NULL references
-				}
+		// compile error
+		handleError();
+		return true;
+	}
 
-				// Object "class_name" initialized to NULL for Py_XDECREF
-				PyObject *valueString = NULL;
-				valueString = PyObject_Str(errorValue); // New Reference or NULL
+	execute(code);
+	Py_DECREF(code);  // release "code" when done
+	return true;
+}
 
-				if(valueString && PyUnicode_Check(valueString))
-				{
-					if(!message.isEmpty())
-						message.append(": ");
+void PythonProgram::execute(PyObject * code)
+{
+	PyObject *main_module = PyImport_ImportModule("__main__"); // New Reference
+	PyObject *main_dict = PyModule_GetDict(main_module); // Borrowed reference
+	Py_INCREF(main_dict); // Incref "main_dict" to use it in PyEval_EvalCode()
+	Py_DECREF(main_module); // // release "main_module" when done
+	PyObject *result = PyEval_EvalCode(code, main_dict, main_dict); // New Reference
 
-					message.append(PyUnicode_AsUTF8(valueString));
-				}
-				Py_XDECREF(valueString); // Use Py_XDECREF() to ignore NULL references
+	if (!result)
+	{
+		handleError();
+	}
+	else
+	{
+		Py_DECREF(result);  // release "result" when done
+	}
+
+	Py_DECREF(main_dict);  // release "main_dict" when done
+}
+
+void PythonProgram::handleError()
+{
+	if (PyErr_Occurred()) // Nothing needs to be done for a borrowed reference
+	{
+		Error(_log,"###### PYTHON EXCEPTION ######");
+		Error(_log,"## In effect '%s'", QSTRING_CSTR(_name));
+		/* Objects all initialized to NULL for Py_XDECREF */
+		PyObject *errorType = NULL, *errorValue = NULL, *errorTraceback = NULL;
+
+		PyErr_Fetch(&errorType, &errorValue, &errorTraceback); // New Reference or NULL
+		PyErr_NormalizeException(&errorType, &errorValue, &errorTraceback);
 
-				Error(_log, "## %s", QSTRING_CSTR(message));
+		// Extract exception message from "errorValue"
+		if(errorValue)
+		{
+			QString message;
+			if(PyObject_HasAttrString(errorValue, "__class__"))
+			{
+				PyObject *classPtr = PyObject_GetAttrString(errorValue, "__class__"); // New Reference
+				PyObject *class_name = NULL; /* Object "class_name" initialized to NULL for Py_XDECREF */
+				class_name = PyObject_GetAttrString(classPtr, "__name__"); // New Reference or NULL
+
+				if(class_name && PyUnicode_Check(class_name))
+					message.append(PyUnicode_AsUTF8(class_name));
+
+				Py_DECREF(classPtr); // release "classPtr" when done
+				Py_XDECREF(class_name); // Use Py_XDECREF() to ignore NULL references
 			}
 
-			// Extract exception message from "errorTraceback"
-			if(errorTraceback)
+			// Object "class_name" initialized to NULL for Py_XDECREF
+			PyObject *valueString = NULL;
+			valueString = PyObject_Str(errorValue); // New Reference or NULL
+
+			if(valueString && PyUnicode_Check(valueString))
 			{
-				// Object "tracebackList" initialized to NULL for Py_XDECREF
-				PyObject *tracebackModule = NULL, *methodName = NULL, *tracebackList = NULL;
-				QString tracebackMsg;
+				if(!message.isEmpty())
+					message.append(": ");
 
-				tracebackModule = PyImport_ImportModule("traceback"); // New Reference or NULL
-				methodName = PyUnicode_FromString("format_exception"); // New Reference or NULL
-				tracebackList = PyObject_CallMethodObjArgs(tracebackModule, methodName, errorType, errorValue, errorTraceback, NULL); // New Reference or NULL
+				message.append(PyUnicode_AsUTF8(valueString));
+			}
+			Py_XDECREF(valueString); // Use Py_XDECREF() to ignore NULL references
 
-				if(tracebackList)
+			Error(_log, "## %s", QSTRING_CSTR(message));
+		}
+
+		// Extract exception message from "errorTraceback"
+		if(errorTraceback)
+		{
+			// Object "tracebackList" initialized to NULL for Py_XDECREF
+			PyObject *tracebackModule = NULL, *methodName = NULL, *tracebackList = NULL;
+			QString tracebackMsg;
+
+			tracebackModule = PyImport_ImportModule("traceback"); // New Reference or NULL
+			methodName = PyUnicode_FromString("format_exception"); // New Reference or NULL
+			tracebackList = PyObject_CallMethodObjArgs(tracebackModule, methodName, errorType, errorValue, errorTraceback, NULL); // New Reference or NULL
+
+			if(tracebackList)
+			{
+				PyObject* iterator = PyObject_GetIter(tracebackList); // New Reference
+
+				PyObject* item;
+				while( (item = PyIter_Next(iterator)) ) // New Reference
 				{
-					PyObject* iterator = PyObject_GetIter(tracebackList); // New Reference
-
-					PyObject* item;
-					while( (item = PyIter_Next(iterator)) ) // New Reference
-					{
-						Error(_log, "## %s",QSTRING_CSTR(QString(PyUnicode_AsUTF8(item)).trimmed()));
-						Py_DECREF(item); // release "item" when done
-					}
-					Py_DECREF(iterator);  // release "iterator" when done
+					Error(_log, "## %s",QSTRING_CSTR(QString(PyUnicode_AsUTF8(item)).trimmed()));
+					Py_DECREF(item); // release "item" when done
 				}
+				Py_DECREF(iterator);  // release "iterator" when done
+			}
 
-				// Use Py_XDECREF() to ignore NULL references
-				Py_XDECREF(tracebackModule);
-				Py_XDECREF(methodName);
-				Py_XDECREF(tracebackList);
+			// Use Py_XDECREF() to ignore NULL references
+			Py_XDECREF(tracebackModule);
+			Py_XDECREF(methodName);
+			Py_XDECREF(tracebackList);
 
-				// Give the exception back to python and print it to stderr in case anyone else wants it.
-				Py_XINCREF(errorType);
-				Py_XINCREF(errorValue);
-				Py_XINCREF(errorTraceback);
+			// Give the exception back to python and print it to stderr in case anyone else wants it.
+			Py_XINCREF(errorType);
+			Py_XINCREF(errorValue);
+			Py_XINCREF(errorTraceback);
 
-				PyErr_Restore(errorType, errorValue, errorTraceback);
-				//PyErr_PrintEx(0); // Remove this line to switch off stderr output
-			}
-			Error(_log,"###### EXCEPTION END ######");
+			PyErr_Restore(errorType, errorValue, errorTraceback);
+			//PyErr_PrintEx(0); // Remove this line to switch off stderr output
 		}
+		Error(_log,"###### EXCEPTION END ######");
 	}
-	else
-	{
-		Py_DECREF(result);  // release "result" when done
-	}
-
-	Py_DECREF(main_dict);  // release "main_dict" when done
 }
 
@@ -1,6 +1,7 @@
 #include "utils/ImageResampler.h"
 #include <utils/ColorSys.h>
 #include <utils/Logger.h>
+#include <utils/PipelineMetrics.h>
 
 ImageResampler::ImageResampler()
 	: _horizontalDecimation(1)
@@ -42,6 +43,8 @@ void ImageResampler::setVideoMode(VideoMode mode)
 
 void ImageResampler::processImage(const uint8_t * data, int width, int height, int lineLength, PixelFormat pixelFormat, Image<ColorRgb> &outputImage) const
 {
+	PipelineStageTimer stageTimer(&PipelineMetrics::capture(), PipelineMetrics::RESAMPLE);
+
 	int cropRight  = _cropRight;
 	int cropBottom = _cropBottom;
 
@@ -61,15 +61,30 @@ namespace JsonUtils {
 		QString cleanData = data;
 		//cleanData .remove(QRegularExpression("([^:]?\\/\\/.*)"));
 
+		return parse(path, cleanData.toUtf8(), doc, log);
+	}
+
+	bool parse(const QString& path, const QByteArray& data, QJsonObject& obj, Logger* log)
+	{
+		QJsonDocument doc;
+		if(!parse(path, data, doc, log))
+			return false;
+
+		obj = doc.object();
+		return true;
+	}
+
+	bool parse(const QString& path, const QByteArray& data, QJsonDocument& doc, Logger* log)
+	{
 		QJsonParseError error;
-		doc = QJsonDocument::fromJson(cleanData.toUtf8(), &error);
+		doc = QJsonDocument::fromJson(data, &error);
 
 		if (error.error != QJsonParseError::NoError)
 		{
 			// report to the user the failure and their locations in the document.
 			int errorLine(0), errorColumn(0);
 
-			for( int i=0, count=qMin( error.offset,cleanData.size()); i<count; ++i )
+			for( int i=0, count=qMin( error.offset,data.size()); i<count; ++i )
 			{
 				++errorColumn;
 				if(data.at(i) == '\n' )
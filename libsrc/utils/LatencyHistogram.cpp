@@ -0,0 +1,136 @@
+#include <utils/LatencyHistogram.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+
+inline int mostSignificantBit(uint64_t value)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanReverse64(&index, value);
+	return static_cast<int>(index);
+#else
+	return 63 - __builtin_clzll(value);
+#endif
+}
+
+}
+
+LatencyHistogram::LatencyHistogram()
+	: _count(0)
+	, _sum(0)
+	, _max(0)
+{
+	for (auto& bucket : _buckets)
+	{
+		bucket.store(0, std::memory_order_relaxed);
+	}
+}
+
+int LatencyHistogram::bucketIndex(uint64_t value)
+{
+	if (value < LINEAR_BUCKETS)
+	{
+		return static_cast<int>(value);
+	}
+
+	const int msb = mostSignificantBit(value);
+	if (msb >= MAX_EXPONENT)
+	{
+		return BUCKET_COUNT - 1;
+	}
+
+	const int sub = static_cast<int>((value >> (msb - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1));
+	return LINEAR_BUCKETS + (msb - 4) * SUB_BUCKETS + sub;
+}
+
+int64_t LatencyHistogram::bucketUpperBound(int index)
+{
+	if (index < LINEAR_BUCKETS)
+	{
+		return index;
+	}
+
+	const int exponent = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 4;
+	const int sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+	const int64_t width = int64_t(1) << (exponent - SUB_BUCKET_BITS);
+	return (SUB_BUCKETS + sub) * width + width - 1;
+}
+
+void LatencyHistogram::record(int64_t value_us)
+{
+	const uint64_t value = value_us > 0 ? static_cast<uint64_t>(value_us) : 0;
+
+	_buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+	_count.fetch_add(1, std::memory_order_relaxed);
+	_sum.fetch_add(value, std::memory_order_relaxed);
+
+	int64_t currentMax = _max.load(std::memory_order_relaxed);
+	while (static_cast<int64_t>(value) > currentMax
+		   && !_max.compare_exchange_weak(currentMax, static_cast<int64_t>(value), std::memory_order_relaxed))
+	{
+	}
+}
+
+void LatencyHistogram::reset()
+{
+	for (auto& bucket : _buckets)
+	{
+		bucket.store(0, std::memory_order_relaxed);
+	}
+	_count.store(0, std::memory_order_relaxed);
+	_sum.store(0, std::memory_order_relaxed);
+	_max.store(0, std::memory_order_relaxed);
+}
+
+double LatencyHistogram::mean() const
+{
+	const uint64_t n = count();
+	return n > 0 ? static_cast<double>(sum()) / n : 0.0;
+}
+
+int64_t LatencyHistogram::percentile(double percentile) const
+{
+	// counts may move while reading, sum up a consistent snapshot first
+	std::array<uint64_t, BUCKET_COUNT> snapshot;
+	uint64_t total = 0;
+	for (int i = 0; i < BUCKET_COUNT; ++i)
+	{
+		snapshot[i] = _buckets[i].load(std::memory_order_relaxed);
+		total += snapshot[i];
+	}
+
+	if (total == 0)
+	{
+		return 0;
+	}
+
+	percentile = qBound(0.0, percentile, 100.0);
+	const uint64_t rank = qMax(uint64_t(1), static_cast<uint64_t>(percentile / 100.0 * total + 0.5));
+
+	uint64_t seen = 0;
+	for (int i = 0; i < BUCKET_COUNT; ++i)
+	{
+		seen += snapshot[i];
+		if (seen >= rank)
+		{
+			return qMin(bucketUpperBound(i), max());
+		}
+	}
+	return max();
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+	QJsonObject summary;
+	summary["count"] = static_cast<qint64>(count());
+	summary["mean"]  = mean();
+	summary["p50"]   = static_cast<qint64>(percentile(50.0));
+	summary["p90"]   = static_cast<qint64>(percentile(90.0));
+	summary["p99"]   = static_cast<qint64>(percentile(99.0));
+	summary["max"]   = static_cast<qint64>(max());
+	return summary;
+}
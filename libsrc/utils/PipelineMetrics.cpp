@@ -0,0 +1,67 @@
+#include <utils/PipelineMetrics.h>
+
+// STL includes
+#include <chrono>
+
+QString PipelineMetrics::stageToString(Stage stage)
+{
+	switch (stage)
+	{
+		case GRAB:          return "grab";
+		case RESAMPLE:      return "resample";
+		case BORDER_DETECT: return "blackborder";
+		case MAP:           return "map";
+		case ADJUST:        return "adjust";
+		case SMOOTH:        return "smoothing";
+		case DEVICE_WRITE:  return "write";
+		case LATENCY:       return "latency";
+		case SMOOTH_JITTER: return "smoothingJitter";
+		default:            return "invalid";
+	}
+}
+
+QString PipelineMetrics::counterToString(Counter counter)
+{
+	switch (counter)
+	{
+		case FRAMES_RENDERED:         return "framesRendered";
+		case FRAMES_SKIPPED:          return "framesSkipped";
+		case DEVICE_WRITE_ERRORS:     return "deviceWriteErrors";
+		case ACTIVE_EFFECTS:          return "activeEffects";
+		case DEVICE_MISSED_DEADLINES: return "deviceMissedDeadlines";
+		case DEVICE_DROPPED_FRAMES:   return "deviceDroppedFrames";
+		default:                      return "invalid";
+	}
+}
+
+PipelineMetrics& PipelineMetrics::capture()
+{
+	static PipelineMetrics captureMetrics;
+	return captureMetrics;
+}
+
+int64_t PipelineMetrics::now_us()
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void PipelineMetrics::reset()
+{
+	for (auto& stage : _stages)
+	{
+		stage.reset();
+	}
+}
+
+QJsonObject PipelineMetrics::toJson() const
+{
+	QJsonObject stages;
+	for (int i = 0; i < STAGE_COUNT; ++i)
+	{
+		if (_stages[i].count() > 0)
+		{
+			stages[stageToString(static_cast<Stage>(i))] = _stages[i].toJson();
+		}
+	}
+	return stages;
+}
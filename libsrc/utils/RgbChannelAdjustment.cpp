@@ -67,3 +67,12 @@ void RgbChannelAdjustment::apply(uint8_t input, uint8_t brightness, uint8_t & re
 	green = _mapping[GREEN][input];
 	blue  = _mapping[BLUE ][input];
 }
+
+void RgbChannelAdjustment::apply(uint16_t input, uint8_t brightness, uint16_t & red, uint16_t & green, uint16_t & blue) const
+{
+	// 255 * 65535 * 255 still fits into 32 bit
+	const uint32_t scaled = static_cast<uint32_t>(brightness) * input;
+	red   = static_cast<uint16_t>(qMin(scaled * _adjust[RED  ] / 65025, static_cast<uint32_t>(UINT16_MAX)));
+	green = static_cast<uint16_t>(qMin(scaled * _adjust[GREEN] / 65025, static_cast<uint32_t>(UINT16_MAX)));
+	blue  = static_cast<uint16_t>(qMin(scaled * _adjust[BLUE ] / 65025, static_cast<uint32_t>(UINT16_MAX)));
+}
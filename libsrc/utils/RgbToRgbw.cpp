@@ -2,69 +2,200 @@
 #include <utils/ColorRgbw.h>
 #include <utils/RgbToRgbw.h>
 #include <utils/Logger.h>
+#include <utils/Simd.h>
 
 namespace RGBW {
 
+namespace {
+
+///
+/// Share of every color channel the white LED replaces: white = min(red * red, green * green, blue * blue),
+/// the inverse factors are the amount of each color channel one step of white contains.
+/// A factor of 0 marks a channel the white LED does not contain.
+///
+struct WhiteFactors
+{
+	float red, green, blue;
+	float invRed, invGreen, invBlue;
+};
+
+WhiteFactors makeWhiteFactors(float red, float green, float blue)
+{
+	return { red, green, blue,
+			 red   > 0.0f ? 1.0f / red   : 0.0f,
+			 green > 0.0f ? 1.0f / green : 0.0f,
+			 blue  > 0.0f ? 1.0f / blue  : 0.0f };
+}
+
+WhiteFactors whiteFactors(WhiteAlgorithm algorithm, const ColorRgb& whiteLedColor)
+{
+	switch (algorithm)
+	{
+		// http://forum.garagecube.com/viewtopic.php?t=10178
+		case WhiteAlgorithm::SUB_MIN_WARM_ADJUST: return makeWhiteFactors(0.274f, 0.454f, 2.333f);
+		case WhiteAlgorithm::SUB_MIN_COOL_ADJUST: return makeWhiteFactors(0.299f, 0.587f, 0.114f);
+		case WhiteAlgorithm::SUB_MIN_CUSTOM_ADJUST:
+			return makeWhiteFactors(whiteLedColor.red   > 0 ? 255.0f / whiteLedColor.red   : 0.0f,
+									whiteLedColor.green > 0 ? 255.0f / whiteLedColor.green : 0.0f,
+									whiteLedColor.blue  > 0 ? 255.0f / whiteLedColor.blue  : 0.0f);
+		default:                                  return makeWhiteFactors(1.0f, 1.0f, 1.0f);
+	}
+}
+
+inline void subtractMinimum(const ColorRgb& input, ColorRgbw& output)
+{
+	output.white = qMin(qMin(input.red, input.green), input.blue);
+	output.red   = input.red   - output.white;
+	output.green = input.green - output.white;
+	output.blue  = input.blue  - output.white;
+}
+
+inline void subtractWeightedMinimum(const ColorRgb& input, ColorRgbw& output, const WhiteFactors& factors)
+{
+	// a channel the white LED does not contain is not limiting the white, without any channel the white stays off
+	float minimum = (factors.red > 0.0f || factors.green > 0.0f || factors.blue > 0.0f) ? 255.0f : 0.0f;
+	if (factors.red > 0.0f)   minimum = qMin(minimum, input.red   * factors.red);
+	if (factors.green > 0.0f) minimum = qMin(minimum, input.green * factors.green);
+	if (factors.blue > 0.0f)  minimum = qMin(minimum, input.blue  * factors.blue);
+
+	const uint8_t white = static_cast<uint8_t>(minimum);
+	output.white = white;
+	output.red   = static_cast<uint8_t>(qMax(0.0f, input.red   - white * factors.invRed));
+	output.green = static_cast<uint8_t>(qMax(0.0f, input.green - white * factors.invGreen));
+	output.blue  = static_cast<uint8_t>(qMax(0.0f, input.blue  - white * factors.invBlue));
+}
+
+inline void whiteOff(const ColorRgb& input, ColorRgbw& output)
+{
+	output.red   = input.red;
+	output.green = input.green;
+	output.blue  = input.blue;
+	output.white = 0;
+}
+
+#if defined(SIMD_SSSE3)
+///
+/// SSSE3 part of subtractMinimum()
+/// @return Number of colors converted
+///
+SIMD_TARGET_SSSE3 size_t subtractMinimumSsse3(const ColorRgb* input, ColorRgbw* output, size_t count)
+{
+	// 4 colors per step, the 16 byte load reads 4 bytes ahead which belong to the next step
+	const __m128i toRgbx = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const __m128i lowByte = _mm_set1_epi32(0xFF);
+	size_t idx = 0;
+	for (; idx + 6 <= count; idx += 4)
+	{
+		const __m128i rgbx = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(input + idx)), toRgbx);
+		const __m128i minimum = _mm_min_epu8(rgbx, _mm_min_epu8(_mm_srli_epi32(rgbx, 8), _mm_srli_epi32(rgbx, 16)));
+		const __m128i white = _mm_and_si128(minimum, lowByte);
+		const __m128i whiteRgb = _mm_or_si128(white, _mm_or_si128(_mm_slli_epi32(white, 8), _mm_slli_epi32(white, 16)));
+		const __m128i rgbw = _mm_or_si128(_mm_subs_epu8(rgbx, whiteRgb), _mm_slli_epi32(white, 24));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(output + idx), rgbw);
+	}
+	return idx;
+}
+#endif
+
+///
+/// Subtract the minimum of all colors, vectorised where available
+///
+void subtractMinimum(const ColorRgb* input, ColorRgbw* output, size_t count)
+{
+	size_t idx = 0;
+#if defined(SIMD_SSSE3)
+	if (simd::hasSsse3())
+	{
+		idx = subtractMinimumSsse3(input, output, count);
+	}
+#elif defined(SIMD_NEON)
+	// 16 colors per step
+	for (; idx + 16 <= count; idx += 16)
+	{
+		const uint8x16x3_t rgb = vld3q_u8(reinterpret_cast<const uint8_t*>(input + idx));
+		const uint8x16_t white = vminq_u8(vminq_u8(rgb.val[0], rgb.val[1]), rgb.val[2]);
+		uint8x16x4_t rgbw;
+		rgbw.val[0] = vsubq_u8(rgb.val[0], white);
+		rgbw.val[1] = vsubq_u8(rgb.val[1], white);
+		rgbw.val[2] = vsubq_u8(rgb.val[2], white);
+		rgbw.val[3] = white;
+		vst4q_u8(reinterpret_cast<uint8_t*>(output + idx), rgbw);
+	}
+#endif
+	for (; idx < count; ++idx)
+	{
+		subtractMinimum(input[idx], output[idx]);
+	}
+}
+
+}
+
 WhiteAlgorithm stringToWhiteAlgorithm(const QString& str)
 {
 	if (str == "subtract_minimum")         return WhiteAlgorithm::SUBTRACT_MINIMUM;
 	if (str == "sub_min_warm_adjust")      return WhiteAlgorithm::SUB_MIN_WARM_ADJUST;
 	if (str == "sub_min_cool_adjust")      return WhiteAlgorithm::SUB_MIN_COOL_ADJUST;
+	if (str == "sub_min_custom_adjust")    return WhiteAlgorithm::SUB_MIN_CUSTOM_ADJUST;
 	if (str.isEmpty() || str == "white_off") return WhiteAlgorithm::WHITE_OFF;
 	return WhiteAlgorithm::INVALID;
 }
 
-void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm)
+void Rgb_to_Rgbw(ColorRgb input, ColorRgbw * output, WhiteAlgorithm algorithm, const ColorRgb& whiteLedColor)
 {
 	switch (algorithm)
 	{
 		case WhiteAlgorithm::SUBTRACT_MINIMUM:
-		{
-			output->white = qMin(qMin(input.red, input.green), input.blue);
-			output->red   = input.red   - output->white;
-			output->green = input.green - output->white;
-			output->blue  = input.blue  - output->white;
+			subtractMinimum(input, *output);
 			break;
-		}
 
 		case WhiteAlgorithm::SUB_MIN_WARM_ADJUST:
-		{
-			// http://forum.garagecube.com/viewtopic.php?t=10178
-			// warm white
-			const float F1(0.274);
-			const float F2(0.454);
-			const float F3(2.333);
-
-			output->white = qMin(input.red*F1,qMin(input.green*F2,input.blue*F3));
-			output->red   = input.red   - output->white/F1;
-			output->green = input.green - output->white/F2;
-			output->blue  = input.blue  - output->white/F3;
+		case WhiteAlgorithm::SUB_MIN_COOL_ADJUST:
+		case WhiteAlgorithm::SUB_MIN_CUSTOM_ADJUST:
+			subtractWeightedMinimum(input, *output, whiteFactors(algorithm, whiteLedColor));
+			break;
+
+		case WhiteAlgorithm::WHITE_OFF:
+			whiteOff(input, *output);
+			break;
+
+		default:
+			break;
+	}
+}
+
+void Rgb_to_Rgbw(const std::vector<ColorRgb>& input, std::vector<ColorRgbw>& output, WhiteAlgorithm algorithm, const ColorRgb& whiteLedColor)
+{
+	const size_t count = input.size();
+	if (output.size() != count)
+	{
+		output.resize(count);
+	}
+
+	switch (algorithm)
+	{
+		case WhiteAlgorithm::SUBTRACT_MINIMUM:
+			subtractMinimum(input.data(), output.data(), count);
 			break;
-		}
 
+		case WhiteAlgorithm::SUB_MIN_WARM_ADJUST:
 		case WhiteAlgorithm::SUB_MIN_COOL_ADJUST:
+		case WhiteAlgorithm::SUB_MIN_CUSTOM_ADJUST:
 		{
-			// http://forum.garagecube.com/viewtopic.php?t=10178
-			// cold white
-			const float F1(0.299);
-			const float F2(0.587);
-			const float F3(0.114);
-
-			output->white = qMin(input.red*F1,qMin(input.green*F2,input.blue*F3));
-			output->red   = input.red   - output->white/F1;
-			output->green = input.green - output->white/F2;
-			output->blue  = input.blue  - output->white/F3;
+			const WhiteFactors factors = whiteFactors(algorithm, whiteLedColor);
+			for (size_t idx = 0; idx < count; ++idx)
+			{
+				subtractWeightedMinimum(input[idx], output[idx], factors);
+			}
 			break;
 		}
 
 		case WhiteAlgorithm::WHITE_OFF:
-		{
-			output->red = input.red;
-			output->green = input.green;
-			output->blue = input.blue;
-			output->white = 0;
+			for (size_t idx = 0; idx < count; ++idx)
+			{
+				whiteOff(input[idx], output[idx]);
+			}
 			break;
-		}
+
 		default:
 			break;
 	}
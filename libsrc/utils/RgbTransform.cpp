@@ -52,6 +52,10 @@ void RgbTransform::initializeMapping()
 		_mappingR[i] = qMin(qMax((int)(qPow(i / 255.0, _gammaR) * 255), 0), 255);
 		_mappingG[i] = qMin(qMax((int)(qPow(i / 255.0, _gammaG) * 255), 0), 255);
 		_mappingB[i] = qMin(qMax((int)(qPow(i / 255.0, _gammaB) * 255), 0), 255);
+
+		_mapping16R[i] = qMin(qMax(qRound(qPow(i / 255.0, _gammaR) * 65535), 0), 65535);
+		_mapping16G[i] = qMin(qMax(qRound(qPow(i / 255.0, _gammaG) * 65535), 0), 65535);
+		_mapping16B[i] = qMin(qMax(qRound(qPow(i / 255.0, _gammaB) * 65535), 0), 65535);
 	}
 }
 
@@ -171,3 +175,47 @@ void RgbTransform::transform(uint8_t & red, uint8_t & green, uint8_t & blue)
 		}
 	}
 }
+
+void RgbTransform::transform(uint8_t red, uint8_t green, uint8_t blue, uint16_t & red16, uint16_t & green16, uint16_t & blue16) const
+{
+	// apply gamma
+	int r = _mapping16R[red];
+	int g = _mapping16G[green];
+	int b = _mapping16B[blue];
+
+	// apply brightnesss, the threshold is given in 8 bit units
+	const double sumBrightnessLow = _sumBrightnessLow * 257;
+	int rgbSum = r+g+b;
+
+	if ( _backLightEnabled && _sumBrightnessLow>0 && rgbSum < sumBrightnessLow)
+	{
+		if (_backlightColored)
+		{
+			if (rgbSum == 0)
+			{
+				// the 16 bit equivalent of 1 in the 8 bit transform
+				if (r==0) r = 257;
+				if (g==0) g = 257;
+				if (b==0) b = 257;
+				rgbSum = r+g+b;
+			}
+			// the same whole-numbered factor as the 8 bit transform, the sum is rgbSum / 257 in 8 bit units
+			const int cL = qMin((int)(sumBrightnessLow / rgbSum), 255);
+
+			r = qMin(r * cL, 65535);
+			g = qMin(g * cL, 65535);
+			b = qMin(b * cL, 65535);
+		}
+		else
+		{
+			// the same level as the 8 bit transform
+			r = qMin((int)(_sumBrightnessLow/3.0), 255) * 257;
+			g = r;
+			b = r;
+		}
+	}
+
+	red16   = static_cast<uint16_t>(r);
+	green16 = static_cast<uint16_t>(g);
+	blue16  = static_cast<uint16_t>(b);
+}
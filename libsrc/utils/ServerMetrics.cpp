@@ -0,0 +1,16 @@
+#include <utils/ServerMetrics.h>
+
+std::array<std::atomic<int64_t>, ServerMetrics::SERVER_COUNT> ServerMetrics::_clients {};
+std::array<std::atomic<int64_t>, ServerMetrics::SERVER_COUNT> ServerMetrics::_receivedBytes {};
+std::array<std::atomic<int64_t>, ServerMetrics::SERVER_COUNT> ServerMetrics::_droppedFrames {};
+
+QString ServerMetrics::serverToString(Server server)
+{
+	switch (server)
+	{
+		case FLATBUFSERVER: return "flatbuffer";
+		case PROTOSERVER:   return "protobuffer";
+		case JSONSERVER:    return "json";
+		default:            return "invalid";
+	}
+}
@@ -0,0 +1,130 @@
+#include "PrometheusExporter.h"
+
+#include <hyperion/HyperionIManager.h>
+#include <utils/ServerMetrics.h>
+
+#include <QStringBuilder>
+#include <QVector>
+#include <QPair>
+
+namespace {
+
+const QString STAGE_METRIC = QStringLiteral("hyperion_stage_duration_seconds");
+
+}
+
+QByteArray PrometheusExporter::collect()
+{
+	_output.clear();
+
+	// label set and metrics of every running instance, the shared metrics stay valid even if an instance stops meanwhile
+	QVector<QPair<QString, QSharedPointer<PipelineMetrics>>> instances;
+	HyperionIManager* instanceManager = HyperionIManager::getInstance();
+	if (instanceManager != nullptr)
+	{
+		const QMap<quint8, HyperionIManager::InstanceMetrics> instanceMetrics = instanceManager->getInstanceMetrics();
+		for (auto it = instanceMetrics.constBegin(); it != instanceMetrics.constEnd(); ++it)
+		{
+			const QString labels = QString("instance=\"%1\",name=\"%2\"").arg(it.key()).arg(escapeLabel(it.value().name));
+			instances.append(qMakePair(labels, it.value().metrics));
+		}
+	}
+
+	const struct
+	{
+		PipelineMetrics::Counter counter;
+		const char* name;
+		const char* type;
+		const char* help;
+	} counters[] = {
+		{ PipelineMetrics::FRAMES_RENDERED,     "hyperion_frames_rendered_total",     "counter", "Number of frames rendered to the LED device" },
+		{ PipelineMetrics::FRAMES_SKIPPED,      "hyperion_frames_skipped_total",      "counter", "Number of render loop ticks skipped as they were too late" },
+		{ PipelineMetrics::DEVICE_WRITE_ERRORS, "hyperion_device_write_errors_total", "counter", "Number of failed LED device writes" },
+		{ PipelineMetrics::ACTIVE_EFFECTS,      "hyperion_effects_active",            "gauge",   "Number of currently running effects" },
+		{ PipelineMetrics::DEVICE_MISSED_DEADLINES, "hyperion_device_missed_deadlines_total", "counter", "Number of LED device output intervals missed by the output thread" },
+		{ PipelineMetrics::DEVICE_DROPPED_FRAMES,   "hyperion_device_dropped_frames_total",   "counter", "Number of frames dropped by the LED device as its link was busy" },
+	};
+
+	for (const auto& counter : counters)
+	{
+		addHeader(counter.name, counter.type, counter.help);
+		for (const auto& instance : instances)
+		{
+			addSample(counter.name, instance.first, instance.second->counter(counter.counter));
+		}
+	}
+
+	addHeader(STAGE_METRIC, "summary", "Duration of the processing pipeline stages, smoothingJitter is the deviation of the smoothing timer from its interval");
+	const PipelineMetrics& capture = PipelineMetrics::capture();
+	for (int i = 0; i < PipelineMetrics::STAGE_COUNT; ++i)
+	{
+		const auto stage = static_cast<PipelineMetrics::Stage>(i);
+		const QString stageLabel = "stage=\"" % PipelineMetrics::stageToString(stage) % "\"";
+		if (capture.histogram(stage).count() > 0)
+		{
+			addSummary(stageLabel, capture.histogram(stage));
+		}
+		for (const auto& instance : instances)
+		{
+			const LatencyHistogram& histogram = instance.second->histogram(stage);
+			if (histogram.count() > 0)
+			{
+				addSummary(instance.first % "," % stageLabel, histogram);
+			}
+		}
+	}
+
+	addHeader("hyperion_server_clients", "gauge", "Number of currently connected clients");
+	for (int i = 0; i < ServerMetrics::SERVER_COUNT; ++i)
+	{
+		const auto server = static_cast<ServerMetrics::Server>(i);
+		addSample("hyperion_server_clients", "server=\"" % ServerMetrics::serverToString(server) % "\"", ServerMetrics::clients(server));
+	}
+
+	addHeader("hyperion_server_received_bytes_total", "counter", "Number of bytes received from clients");
+	for (int i = 0; i < ServerMetrics::SERVER_COUNT; ++i)
+	{
+		const auto server = static_cast<ServerMetrics::Server>(i);
+		addSample("hyperion_server_received_bytes_total", "server=\"" % ServerMetrics::serverToString(server) % "\"", ServerMetrics::receivedBytes(server));
+	}
+
+	addHeader("hyperion_server_dropped_frames_total", "counter", "Number of incomplete or late frames dropped");
+	for (int i = 0; i < ServerMetrics::SERVER_COUNT; ++i)
+	{
+		const auto server = static_cast<ServerMetrics::Server>(i);
+		addSample("hyperion_server_dropped_frames_total", "server=\"" % ServerMetrics::serverToString(server) % "\"", ServerMetrics::droppedFrames(server));
+	}
+
+	return _output.toUtf8();
+}
+
+void PrometheusExporter::addHeader(const QString& name, const QString& type, const QString& help)
+{
+	_output += "# HELP " % name % " " % help % "\n";
+	_output += "# TYPE " % name % " " % type % "\n";
+}
+
+void PrometheusExporter::addSample(const QString& name, const QString& labels, double value)
+{
+	_output += name;
+	if (!labels.isEmpty())
+	{
+		_output += "{" % labels % "}";
+	}
+	_output += " " % QString::number(value, 'g', 12) % "\n";
+}
+
+void PrometheusExporter::addSummary(const QString& labels, const LatencyHistogram& histogram)
+{
+	for (const double quantile : { 0.5, 0.9, 0.99 })
+	{
+		addSample(STAGE_METRIC, labels % ",quantile=\"" % QString::number(quantile) % "\"", histogram.percentile(quantile * 100.0) / 1e6);
+	}
+	addSample(STAGE_METRIC % "_sum", labels, static_cast<double>(histogram.sum()) / 1e6);
+	addSample(STAGE_METRIC % "_count", labels, static_cast<double>(histogram.count()));
+}
+
+QString PrometheusExporter::escapeLabel(QString value)
+{
+	return value.replace('\\', "\\\\").replace('"', "\\\"").replace('\n', "\\n");
+}
@@ -0,0 +1,39 @@
+#ifndef PROMETHEUSEXPORTER_H
+#define PROMETHEUSEXPORTER_H
+
+#include <QByteArray>
+#include <QString>
+
+#include <utils/PipelineMetrics.h>
+
+///
+/// @brief Render the pipeline and server metrics in the Prometheus text exposition format (version 0.0.4)
+///
+/// Scraped via GET /metrics of the webserver. The metrics of the running instances are taken from HyperionIManager::getInstanceMetrics(),
+/// so no instance state is accessed from the thread of the webserver. The values themselves are read lock-free.
+///
+class PrometheusExporter
+{
+public:
+	///
+	/// @brief Collect all metrics
+	/// @return The metrics document
+	///
+	QByteArray collect();
+
+	///
+	/// @brief The content type of the document
+	///
+	static QByteArray contentType() { return QByteArrayLiteral("text/plain; version=0.0.4; charset=utf-8"); }
+
+private:
+	void addHeader(const QString& name, const QString& type, const QString& help);
+	void addSample(const QString& name, const QString& labels, double value);
+	void addSummary(const QString& labels, const LatencyHistogram& histogram);
+
+	static QString escapeLabel(QString value);
+
+	QString _output;
+};
+
+#endif // PROMETHEUSEXPORTER_H
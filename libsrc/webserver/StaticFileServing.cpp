@@ -1,6 +1,9 @@
 
 #include "StaticFileServing.h"
+#include "PrometheusExporter.h"
 #include <utils/QStringUtils.h>
+#include <utils/NetOrigin.h>
+#include <hyperion/AuthManager.h>
 
 #include <QStringBuilder>
 #include <QUrlQuery>
@@ -76,6 +79,27 @@ void StaticFileServing::printErrorToReply (QtHttpReply * reply, QtHttpReply::Sta
 	}
 }
 
+bool StaticFileServing::isMetricsAuthorized (QtHttpRequest * request) const
+{
+	AuthManager * authManager = AuthManager::getInstance();
+	const QtHttpRequest::ClientInfo info = request->getClientInfo();
+
+	// local connections are authorized if the network allows unauthorized locals or local admin access
+	if (NetOrigin::getInstance()->isLocalAddress(info.clientAddress, info.serverAddress))
+	{
+		if ((authManager->isAuthRequired() && !authManager->isLocalAuthRequired()) || !authManager->isLocalAdminAuthRequired())
+		{
+			return true;
+		}
+	}
+
+	// all others need a token from the http Authorization header, "token <token>"
+	const QString token = QString::fromUtf8(request->getHeader("Authorization")).mid(5).trimmed();
+	bool res = false;
+	QMetaObject::invokeMethod(authManager, "isTokenAuthorized", Qt::BlockingQueuedConnection, Q_RETURN_ARG(bool, res), Q_ARG(QString, token));
+	return res;
+}
+
 void StaticFileServing::onRequestNeedsReply (QtHttpRequest * request, QtHttpReply * reply)
 {
 	QString command = request->getCommand ();
@@ -106,6 +130,19 @@ void StaticFileServing::onRequestNeedsReply (QtHttpRequest * request, QtHttpRepl
 				reply->appendRawData (_ssdpDescription);
 				return;
 			}
+			else if(uri_parts.at(0) == "metrics")
+			{
+				if (!isMetricsAuthorized(request))
+				{
+					printErrorToReply (reply, QtHttpReply::Forbidden, "No Authorization");
+					return;
+				}
+
+				PrometheusExporter exporter;
+				reply->addHeader ("Content-Type", PrometheusExporter::contentType());
+				reply->appendRawData (exporter.collect());
+				return;
+			}
 		}
 
 		QFileInfo info(_baseUrl % "/" % path);
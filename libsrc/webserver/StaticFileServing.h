@@ -41,6 +41,14 @@ private:
 
 	void printErrorToReply (QtHttpReply * reply, QtHttpReply::StatusCode code, QString errorMessage);
 
+	///
+	/// @brief Check if the request may read the metrics, with the same rules as the JSON API
+	/// (local connections as configured, others with a token in the Authorization header)
+	/// @param request The request
+	/// @return True if authorized
+	///
+	bool isMetricsAuthorized (QtHttpRequest * request) const;
+
 };
 
 #endif // STATICFILESERVING_H
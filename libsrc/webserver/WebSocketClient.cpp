@@ -25,6 +25,8 @@ WebSocketClient::WebSocketClient(QtHttpRequest* request, QTcpSocket* sock, bool
 	// Json processor
 	_jsonAPI = new JsonAPI(client, _log, localConnection, this);
 	connect(_jsonAPI, &JsonAPI::callbackMessage, this, &WebSocketClient::sendMessage);
+	connect(_jsonAPI, &JsonAPI::callbackBinaryMessage, this, &WebSocketClient::sendBinaryMessage);
+	_jsonAPI->setBinaryStreamingSupported(true);
 	connect(_jsonAPI, &JsonAPI::forceClose, this,[this]() { this->sendClose(CLOSECODE::NORMAL); });
 
 	Debug(_log, "New connection from %s", QSTRING_CSTR(client));
@@ -120,7 +122,7 @@ void WebSocketClient::handleWebSocketFrame()
 				if (_wsh.opCode == OPCODE::TEXT)
 				{
 
-						_jsonAPI->handleMessage(QString(_wsReceiveBuffer));
+						_jsonAPI->handleMessage(_wsReceiveBuffer);
 				}
 				else
 				{
@@ -259,6 +261,16 @@ qint64 WebSocketClient::sendMessage(QJsonObject obj)
 	QJsonDocument writer(obj);
 	QByteArray data = writer.toJson(QJsonDocument::Compact) + "\n";
 
+	return sendFrames(OPCODE::TEXT, data);
+}
+
+qint64 WebSocketClient::sendBinaryMessage(QByteArray data)
+{
+	return sendFrames(OPCODE::BINARY, data);
+}
+
+qint64 WebSocketClient::sendFrames(quint8 opCode, const QByteArray &data)
+{
 	if (!_socket || (_socket->state() != QAbstractSocket::ConnectedState)) return 0;
 
 	qint64 payloadWritten = 0;
@@ -274,7 +286,8 @@ qint64 WebSocketClient::sendMessage(QJsonObject obj)
 		quint64 position  = i * FRAME_SIZE_IN_BYTES;
 		quint32 frameSize = (payloadSize-position >= FRAME_SIZE_IN_BYTES) ? FRAME_SIZE_IN_BYTES : (payloadSize-position);
 
-		QByteArray buf = makeFrameHeader(OPCODE::TEXT, frameSize, isLastFrame);
+		// continuation frames carry opcode 0
+		QByteArray buf = makeFrameHeader(i == 0 ? opCode : quint8(OPCODE::CONTINUATION), frameSize, isLastFrame);
 		sendMessage_Raw(buf);
 
 		qint64 written = sendMessage_Raw(payload+position,frameSize);
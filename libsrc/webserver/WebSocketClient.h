@@ -36,6 +36,7 @@ private:
 	qint64 sendMessage_Raw(const char* data, quint64 size);
 	qint64 sendMessage_Raw(QByteArray &data);
 	QByteArray makeFrameHeader(quint8 opCode, quint64 payloadLength, bool lastFrame);
+	qint64 sendFrames(quint8 opCode, const QByteArray &data);
 
 	/// The buffer used for reading data from the socket
 	QByteArray _receiveBuffer;
@@ -70,4 +71,5 @@ private:
 private slots:
 	void handleWebSocketFrame();
 	qint64 sendMessage(QJsonObject obj);
+	qint64 sendBinaryMessage(QByteArray data);
 };
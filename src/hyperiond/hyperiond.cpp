@@ -17,6 +17,7 @@
 #include <utils/Components.h>
 #include <utils/JsonUtils.h>
 #include <utils/Image.h>
+#include <utils/ColorRgb16.h>
 
 #include <HyperionConfig.h> // Required to determine the cmake options
 
@@ -94,6 +95,7 @@ HyperionDaemon::HyperionDaemon(const QString rootPath, QObject *parent, bool log
 	qRegisterMetaType<VideoMode>("VideoMode");
 	qRegisterMetaType<QMap<quint8, QJsonObject>>("QMap<quint8,QJsonObject>");
 	qRegisterMetaType<std::vector<ColorRgb>>("std::vector<ColorRgb>");
+	qRegisterMetaType<std::vector<ColorRgb16>>("std::vector<ColorRgb16>");
 
 	// init settings
 	_settingsManager = new SettingsManager(0, this);
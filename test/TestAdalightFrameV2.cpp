@@ -0,0 +1,226 @@
+// STL includes
+#include <iostream>
+#include <vector>
+
+// LedDevice includes
+#include <leddevice/dev_serial/AdalightFrameV2.h>
+
+///
+/// Apply a frame to the LEDs like the reference sketch (assets/firmware/arduino/adalight_v2) does
+/// @return True, if the sketch would accept and show the frame
+///
+bool applyFrame(const std::vector<uint8_t>& frame, int size, std::vector<ColorRgb>& leds)
+{
+	if (size < AdalightFrameV2::HEADER_SIZE + 1 || frame[0] != 'A' || frame[1] != 'd' || frame[2] != 'b'
+		|| frame[5] != (frame[3] ^ frame[4] ^ 0x55))
+	{
+		return false;
+	}
+
+	long remaining = (long(frame[3]) << 8) + frame[4];
+	if (remaining + AdalightFrameV2::HEADER_SIZE + 1 != size)
+	{
+		return false;
+	}
+
+	std::vector<ColorRgb> shown = leds;
+	uint8_t checksum = 0x55;
+	int pos = AdalightFrameV2::HEADER_SIZE;
+	auto readColor = [&]() {
+		ColorRgb color = { frame[pos], frame[pos + 1], frame[pos + 2] };
+		checksum ^= frame[pos] ^ frame[pos + 1] ^ frame[pos + 2];
+		pos += 3;
+		return color;
+	};
+
+	while (remaining >= 4)
+	{
+		const int start = (frame[pos] << 8) + frame[pos + 1];
+		const int count = frame[pos + 2];
+		const int mode = frame[pos + 3];
+		checksum ^= frame[pos] ^ frame[pos + 1] ^ frame[pos + 2] ^ frame[pos + 3];
+		pos += 4;
+		remaining -= 4;
+
+		if (mode == AdalightFrameV2::SEGMENT_RUN)
+		{
+			const ColorRgb color = readColor();
+			remaining -= 3;
+			for (int idx = start; idx < start + count && idx < int(shown.size()); ++idx)
+				shown[idx] = color;
+		}
+		else
+		{
+			for (int idx = start; idx < start + count; ++idx)
+			{
+				const ColorRgb color = readColor();
+				if (idx < int(shown.size()))
+					shown[idx] = color;
+			}
+			remaining -= 3L * count;
+		}
+	}
+
+	if (remaining != 0 || frame[pos] != checksum)
+	{
+		return false;
+	}
+
+	leds = shown;
+	return true;
+}
+
+std::vector<ColorRgb> createColors(int count, int seed)
+{
+	std::vector<ColorRgb> colors(count);
+	for (int i = 0; i < count; ++i)
+	{
+		colors[i] = { uint8_t(i * 7 + seed), uint8_t(i * 13 + seed), uint8_t(i * 31 + seed) };
+	}
+	return colors;
+}
+
+
+int TC_KEY_FRAME()
+{
+	int result = 0;
+
+	const int ledCount = 600;
+	std::vector<uint8_t> frame(AdalightFrameV2::bufferSize(ledCount));
+	std::vector<ColorRgb> controller(ledCount, ColorRgb::BLACK);
+	const std::vector<ColorRgb> colors = createColors(ledCount, 1);
+
+	const int size = AdalightFrameV2::encode(frame.data(), colors, controller, ledCount, true);
+	if (size <= 0 || size > int(frame.size()) || !applyFrame(frame, size, controller) || controller != colors)
+	{
+		std::cerr << "Failed to show all colors of a key frame" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly showed all colors of a key frame" << std::endl;
+
+	if (AdalightFrameV2::encode(frame.data(), colors, controller, ledCount, false) != 0)
+	{
+		std::cerr << "Failed to skip the frame of unchanged colors" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly skipped the frame of unchanged colors" << std::endl;
+
+	return result;
+}
+
+int TC_DELTA_FRAME()
+{
+	int result = 0;
+
+	const int ledCount = 600;
+	std::vector<uint8_t> frame(AdalightFrameV2::bufferSize(ledCount));
+	std::vector<ColorRgb> controller = createColors(ledCount, 1);
+
+	std::vector<ColorRgb> changed = controller;
+	changed[0] = ColorRgb::RED;
+	changed[100] = ColorRgb::GREEN;
+	changed[102] = ColorRgb::BLUE;	// a single unchanged LED in between
+	changed[ledCount - 1] = ColorRgb::WHITE;
+
+	const int size = AdalightFrameV2::encode(frame.data(), changed, controller, ledCount, false);
+	if (size <= 0 || size >= AdalightFrameV2::HEADER_SIZE + 4 * (AdalightFrameV2::SEGMENT_HEADER_SIZE + 3 * 3) + 1)
+	{
+		std::cerr << "Failed to send the changed colors only" << std::endl;
+		result = -1;
+	}
+	else if (!applyFrame(frame, size, controller) || controller != changed)
+	{
+		std::cerr << "Failed to show the changes of a delta frame" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly showed the changes of a delta frame" << std::endl;
+
+	return result;
+}
+
+int TC_RUNS()
+{
+	int result = 0;
+
+	const int ledCount = 600;
+	std::vector<uint8_t> frame(AdalightFrameV2::bufferSize(ledCount));
+	std::vector<ColorRgb> controller = createColors(ledCount, 1);
+
+	const std::vector<ColorRgb> uniform(ledCount, ColorRgb::YELLOW);
+	int size = AdalightFrameV2::encode(frame.data(), uniform, controller, ledCount, false);
+	if (size <= 0 || size >= 40 || !applyFrame(frame, size, controller) || controller != uniform)
+	{
+		std::cerr << "Failed to send runs of identical colors once" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly sent runs of identical colors once" << std::endl;
+
+	std::vector<ColorRgb> mixed = createColors(ledCount, 5);
+	for (int i = 200; i < 520; ++i)
+		mixed[i] = { 0, 200, 255 };
+	size = AdalightFrameV2::encode(frame.data(), mixed, controller, ledCount, false);
+	if (!applyFrame(frame, size, controller) || controller != mixed)
+	{
+		std::cerr << "Failed to show a frame of raw and run segments" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly showed a frame of raw and run segments" << std::endl;
+
+	return result;
+}
+
+int TC_UNKNOWN_CONTROLLER()
+{
+	int result = 0;
+
+	const int ledCount = 600;
+	std::vector<uint8_t> frame(AdalightFrameV2::bufferSize(ledCount));
+	const std::vector<ColorRgb> colors = createColors(ledCount, 1);
+	std::vector<ColorRgb> unknown;
+	std::vector<ColorRgb> leds(ledCount, ColorRgb::BLACK);
+
+	const int size = AdalightFrameV2::encode(frame.data(), colors, unknown, ledCount, false);
+	if (!applyFrame(frame, size, leds) || leds != colors)
+	{
+		std::cerr << "Failed to send all LEDs if the controller's colors are unknown" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly sent all LEDs if the controller's colors are unknown" << std::endl;
+
+	return result;
+}
+
+int TC_CORRUPTED()
+{
+	int result = 0;
+
+	const int ledCount = 600;
+	std::vector<uint8_t> frame(AdalightFrameV2::bufferSize(ledCount));
+	const std::vector<ColorRgb> colors = createColors(ledCount, 1);
+	const std::vector<ColorRgb> changed = createColors(ledCount, 2);
+
+	const int size = AdalightFrameV2::encode(frame.data(), changed, colors, ledCount, true);
+	frame[AdalightFrameV2::HEADER_SIZE + 10] ^= 0x01;
+	std::vector<ColorRgb> rejected = colors;
+	if (applyFrame(frame, size, rejected))
+	{
+		std::cerr << "Failed to reject a corrupted frame by the checksum" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly rejected a corrupted frame by the checksum" << std::endl;
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_KEY_FRAME();
+	result |= TC_DELTA_FRAME();
+	result |= TC_RUNS();
+	result |= TC_UNKNOWN_CONTROLLER();
+	result |= TC_CORRUPTED();
+
+	return result;
+}
@@ -0,0 +1,183 @@
+// STL includes
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+// Flatbuffer server includes
+#include <flatbufserver/FrameAssembler.h>
+
+std::vector<uint8_t> createFrame(uint32_t size)
+{
+	std::vector<uint8_t> frame(size);
+	for (uint32_t i = 0; i < size; ++i)
+		frame[i] = uint8_t(i * 7 + 3);
+	return frame;
+}
+
+FrameAssembler::Result addFragment(FrameAssembler& assembler, const std::vector<uint8_t>& frame, uint32_t offset, uint32_t length)
+{
+	return assembler.add(offset, frame.data() + offset, length);
+}
+
+bool isFrameEqual(const FrameAssembler& assembler, const std::vector<uint8_t>& frame)
+{
+	return assembler.frame().size() == int(frame.size())
+		&& std::equal(frame.begin(), frame.end(), reinterpret_cast<const uint8_t*>(assembler.frame().constData()));
+}
+
+int TC_IN_ORDER()
+{
+	int result = 0;
+
+	const std::vector<uint8_t> frame = createFrame(3000);
+	FrameAssembler assembler;
+	assembler.start(3000);
+
+	if (addFragment(assembler, frame, 0, 1400) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 1400, 1400) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 2800, 200) != FrameAssembler::Complete)
+	{
+		std::cerr << "Failed to complete a frame with fragments in order" << std::endl;
+		result = -1;
+	}
+	else if (!isFrameEqual(assembler, frame) || assembler.isActive())
+	{
+		std::cerr << "Failed to assemble the content of a frame with fragments in order" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly assembled a frame with fragments in order" << std::endl;
+
+	return result;
+}
+
+int TC_REORDERED()
+{
+	int result = 0;
+
+	const std::vector<uint8_t> frame = createFrame(3000);
+	FrameAssembler assembler;
+	assembler.start(3000);
+
+	if (addFragment(assembler, frame, 2800, 200) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 0, 1400) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 1400, 1400) != FrameAssembler::Complete
+		|| !isFrameEqual(assembler, frame))
+	{
+		std::cerr << "Failed to assemble a frame with reordered fragments" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly assembled a frame with reordered fragments" << std::endl;
+
+	return result;
+}
+
+int TC_DUPLICATED()
+{
+	int result = 0;
+
+	const std::vector<uint8_t> frame = createFrame(3000);
+	FrameAssembler assembler;
+	assembler.start(3000);
+
+	// a duplicate must not complete a frame which still has a gap
+	if (addFragment(assembler, frame, 0, 1400) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 0, 1400) != FrameAssembler::Ignored
+		|| addFragment(assembler, frame, 1400, 1400) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 1400, 1400) != FrameAssembler::Ignored
+		|| addFragment(assembler, frame, 2800, 200) != FrameAssembler::Complete
+		|| !isFrameEqual(assembler, frame))
+	{
+		std::cerr << "Failed to ignore duplicated fragments" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly ignored duplicated fragments" << std::endl;
+
+	return result;
+}
+
+int TC_OVERLAPPING()
+{
+	int result = 0;
+
+	const std::vector<uint8_t> frame = createFrame(3000);
+	FrameAssembler assembler;
+	assembler.start(3000);
+
+	if (addFragment(assembler, frame, 1000, 1000) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 500, 1000) != FrameAssembler::Ignored
+		|| addFragment(assembler, frame, 1500, 1000) != FrameAssembler::Ignored
+		|| addFragment(assembler, frame, 0, 3000) != FrameAssembler::Ignored
+		|| addFragment(assembler, frame, 0, 1000) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 2000, 1000) != FrameAssembler::Complete
+		|| !isFrameEqual(assembler, frame))
+	{
+		std::cerr << "Failed to ignore overlapping fragments" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly ignored overlapping fragments" << std::endl;
+
+	return result;
+}
+
+int TC_GAP()
+{
+	int result = 0;
+
+	const std::vector<uint8_t> frame = createFrame(3000);
+	FrameAssembler assembler;
+	assembler.start(3000);
+
+	if (addFragment(assembler, frame, 0, 1400) != FrameAssembler::Incomplete
+		|| addFragment(assembler, frame, 2800, 200) != FrameAssembler::Incomplete
+		|| !assembler.isActive())
+	{
+		std::cerr << "Failed to keep a frame with a gap incomplete" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly kept a frame with a gap incomplete" << std::endl;
+
+	return result;
+}
+
+int TC_INVALID()
+{
+	int result = 0;
+
+	const std::vector<uint8_t> frame = createFrame(3000);
+	FrameAssembler assembler;
+	assembler.start(3000);
+
+	if (addFragment(assembler, frame, 2999, 1) != FrameAssembler::Incomplete
+		|| assembler.add(3000, frame.data(), 1) != FrameAssembler::Ignored
+		|| assembler.add(2000, frame.data(), 1001) != FrameAssembler::Ignored
+		|| assembler.add(0, frame.data(), 0) != FrameAssembler::Ignored)
+	{
+		std::cerr << "Failed to ignore fragments outside the frame" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly ignored fragments outside the frame" << std::endl;
+
+	assembler.reset();
+	if (addFragment(assembler, frame, 0, 1400) != FrameAssembler::Ignored)
+	{
+		std::cerr << "Failed to ignore a fragment without frame in assembly" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly ignored a fragment without frame in assembly" << std::endl;
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_IN_ORDER();
+	result |= TC_REORDERED();
+	result |= TC_DUPLICATED();
+	result |= TC_OVERLAPPING();
+	result |= TC_GAP();
+	result |= TC_INVALID();
+
+	return result;
+}
@@ -0,0 +1,137 @@
+// STL includes
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+// LedDevice includes
+#include <leddevice/TemporalDither.h>
+
+int TC_EXACT_8BIT()
+{
+	int result = 0;
+
+	// every 8 bit value x as x * 257 on all channels
+	std::vector<ColorRgb16> values(256);
+	for (int x = 0; x < 256; ++x)
+	{
+		values[x] = { uint16_t(x * 257), uint16_t(x * 257), uint16_t(x * 257) };
+	}
+
+	TemporalDither dither;
+	bool isUnchanged = true;
+	for (int write = 0; write < 1000 && isUnchanged; ++write)
+	{
+		const std::vector<ColorRgb>& frame = dither.dither(values);
+		for (int x = 0; x < 256; ++x)
+		{
+			isUnchanged = isUnchanged && frame[x].red == x && frame[x].green == x && frame[x].blue == x;
+		}
+	}
+
+	if (!isUnchanged)
+	{
+		std::cerr << "Failed to write exact 8 bit values unchanged" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly wrote exact 8 bit values unchanged" << std::endl;
+
+	return result;
+}
+
+int TC_AVERAGE()
+{
+	int result = 0;
+
+	// all 16 bit values, spread over the channels of the LEDs
+	std::vector<ColorRgb16> values(65536 / 3 + 1);
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		values[i] = { uint16_t(i * 3), uint16_t(std::min<size_t>(i * 3 + 1, 65535)), uint16_t(std::min<size_t>(i * 3 + 2, 65535)) };
+	}
+
+	TemporalDither dither;
+	std::vector<uint32_t> sums(values.size() * 3, 0);
+	bool isInRange = true;
+	for (int write = 0; write < 257; ++write)
+	{
+		const std::vector<ColorRgb>& frame = dither.dither(values);
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			sums[i * 3]     += frame[i].red;
+			sums[i * 3 + 1] += frame[i].green;
+			sums[i * 3 + 2] += frame[i].blue;
+
+			// a written value is one of the two 8 bit values enclosing the 16 bit value
+			isInRange = isInRange && frame[i].red >= values[i].red / 257 && frame[i].red <= values[i].red / 257 + 1;
+		}
+	}
+
+	bool isExact = true;
+	for (size_t i = 0; i < values.size(); ++i)
+	{
+		isExact = isExact && sums[i * 3] == values[i].red && sums[i * 3 + 1] == values[i].green && sums[i * 3 + 2] == values[i].blue;
+	}
+
+	if (!isInRange)
+	{
+		std::cerr << "Failed to write values enclosing the 16 bit value" << std::endl;
+		result = -1;
+	}
+	else if (!isExact)
+	{
+		std::cerr << "Failed to approach the 16 bit value by the sum of 257 writes" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly approached the 16 bit values by 257 writes" << std::endl;
+
+	return result;
+}
+
+int TC_CHANGING_LED_COUNT()
+{
+	int result = 0;
+
+	TemporalDither dither;
+	dither.dither(std::vector<ColorRgb16>(10, ColorRgb16{ 100, 200, 300 }));
+	const std::vector<ColorRgb>& frame = dither.dither(std::vector<ColorRgb16>(20, ColorRgb16::fromRgb(ColorRgb::WHITE)));
+
+	if (frame.size() != 20 || frame[19] != ColorRgb::WHITE)
+	{
+		std::cerr << "Failed to start a new LED count without carried over fractions" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly started a new LED count without carried over fractions" << std::endl;
+
+	return result;
+}
+
+int TC_ROUND()
+{
+	int result = 0;
+
+	TemporalDither dither;
+	const std::vector<ColorRgb16> values = { { 0, 128, 129 }, { 385, 386, 65535 }, { 257 * 100, 257 * 100 + 128, 257 * 100 + 129 } };
+	const std::vector<ColorRgb> expected = { { 0, 0, 1 }, { 1, 2, 255 }, { 100, 100, 101 } };
+
+	// rounding carries nothing over, the same values are written every time
+	if (dither.round(values) != expected || dither.round(values) != expected)
+	{
+		std::cerr << "Failed to round to the nearest 8 bit values" << std::endl;
+		result = -1;
+	}
+	else std::cout << "Correctly rounded to the nearest 8 bit values" << std::endl;
+
+	return result;
+}
+
+int main()
+{
+	int result = 0;
+
+	result |= TC_EXACT_8BIT();
+	result |= TC_AVERAGE();
+	result |= TC_CHANGING_LED_COUNT();
+	result |= TC_ROUND();
+
+	return result;
+}